@@ -0,0 +1,42 @@
+
+/**
+ * Validation metrics of cross validation aggregated over folds.
+ * Arrays are numbIteration * numbEval, iteration major.
+ */
+public class CrossValidationResult {
+    private float[] mean;
+    private float[] stdv;
+    private int numbEval;
+    private int numbIteration;
+
+    public CrossValidationResult(float[] mean, float[] stdv, int numbEval, int numbIteration) {
+        this.mean = mean;
+        this.stdv = stdv;
+        this.numbEval = numbEval;
+        this.numbIteration = numbIteration;
+    }
+
+    public float getMean(int iteration, int eval) {
+        return mean[iteration * numbEval + eval];
+    }
+
+    public float getStdv(int iteration, int eval) {
+        return stdv[iteration * numbEval + eval];
+    }
+
+    public float[] getMean() {
+        return mean;
+    }
+
+    public float[] getStdv() {
+        return stdv;
+    }
+
+    public int getNumbEval() {
+        return numbEval;
+    }
+
+    public int getNumbIteration() {
+        return numbIteration;
+    }
+}
@@ -0,0 +1,59 @@
+
+/**
+ * Compares text and binary dataset load times.
+ * Usage: DatasetLoadBenchmark textFile binaryFile [parameters] [repeats]
+ * binaryFile is written from textFile when it does not exist yet.
+ * The file loader takes textFile + ".bin" over textFile whenever it exists,
+ * so that name is refused, otherwise the text timing would measure binary loads.
+ */
+public class DatasetLoadBenchmark {
+
+    private interface Loader {
+        DatesetHandle load();
+    }
+
+    public static void main(String[] args) {
+        final String textFile = args[0];
+        final String binaryFile = args[1];
+        final String params = args.length > 2 ? args[2] : "";
+        int repeats = args.length > 3 ? Integer.parseInt(args[3]) : 5;
+
+        if (new java.io.File(textFile + ".bin").exists() || binaryFile.equals(textFile + ".bin")) {
+            System.out.println(textFile + ".bin shadows the text file, pick another binaryFile name");
+            return;
+        }
+
+        final ILightGBMJava lib = new ILightGBMJava();
+        if (!new java.io.File(binaryFile).exists()) {
+            DatesetHandle text = lib.createDatasetFromFile(textFile, params, null);
+            lib.datasetSaveBinary(text, binaryFile);
+            lib.datasetFree(text);
+        }
+
+        run(lib, "text", repeats, new Loader() {
+            public DatesetHandle load() {
+                return lib.createDatasetFromFile(textFile, params, null);
+            }
+        });
+        run(lib, "binary", repeats, new Loader() {
+            public DatesetHandle load() {
+                return lib.createDatasetFromBinaryFile(binaryFile, params);
+            }
+        });
+    }
+
+    private static void run(ILightGBMJava lib, String name, int repeats, Loader loader) {
+        long best = Long.MAX_VALUE;
+        long total = 0;
+        for (int i = 0; i < repeats; i++) {
+            long start = System.nanoTime();
+            DatesetHandle handle = loader.load();
+            long elapsed = System.nanoTime() - start;
+            lib.datasetFree(handle);
+            best = Math.min(best, elapsed);
+            total += elapsed;
+        }
+        System.out.println(String.format("%-12s best %8.1f ms, mean %8.1f ms",
+                name, best / 1e6, total / 1e6 / repeats));
+    }
+}
@@ -0,0 +1,28 @@
+
+/**
+ * Native mapping of model features onto columns of a wider upstream row.
+ * Build once per model and reuse for every prediction.
+ */
+public class FeatureProjection {
+    private long nativePtr;
+    private int numbFeature;
+    private int numbUpstreamColumn;
+
+    public FeatureProjection(long nativePtr, int numbFeature, int numbUpstreamColumn) {
+        this.nativePtr = nativePtr;
+        this.numbFeature = numbFeature;
+        this.numbUpstreamColumn = numbUpstreamColumn;
+    }
+
+    public long getNativePtr() {
+        return nativePtr;
+    }
+
+    public int getNumbFeature() {
+        return numbFeature;
+    }
+
+    public int getNumbUpstreamColumn() {
+        return numbUpstreamColumn;
+    }
+}
@@ -1,10 +1,24 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
 
+/**
+ * JNI bindings of LightGBM c_api.
+ * Failed native calls throw LightGBMException carrying the error code and message,
+ * return values on failure are never observed.
+ */
 public class ILightGBMJava{
 
     public enum PREDICT_TYPE{
         PREDICT_NORMAL, PREDICT_RAW_SCORE, PREDICT_LEAF_INDEX
     }
 
+    public static final int C_API_DTYPE_FLOAT32 = 0;
+    public static final int C_API_DTYPE_FLOAT64 = 1;
+    public static final int C_API_DTYPE_INT32 = 2;
+    public static final int C_API_DTYPE_INT64 = 3;
+
     static {
         System.loadLibrary("LightGBMJni");
     }
@@ -16,6 +30,29 @@ public class ILightGBMJava{
                                                       String parameters,
                                                       DatesetHandle handle);
 
+    /**
+     * Load dataset written by datasetSaveBinary, bin mappers are taken from the file.
+     * Files without the LightGBM binary token are refused instead of parsed as text.
+     * LightGBM reads the file into its own heap copy, nothing is shared between processes.
+     */
+    public native DatesetHandle createDatasetFromBinaryFile(String filename,
+                                                            String parameters);
+
+    /**
+     * Create dataset from in memory dense matrix
+     * @param reference used to align bin mappers with other dataset, null means not used
+     */
+    public native DatesetHandle createDatasetFromMat(float[] data,
+                                                     int rowsNumb,
+                                                     int colNumb,
+                                                     boolean isRowMajor,
+                                                     String parameters,
+                                                     DatesetHandle reference);
+
+    /**
+     * @return message of the last failed LightGBM call on this thread,
+     * failed calls already throw LightGBMException carrying it
+     */
     public native String getLastError();
 
     public native int datasetFree(DatesetHandle handle);
@@ -38,6 +75,236 @@ public class ILightGBMJava{
                                                PREDICT_TYPE predict_type,
                                                long numbIteration);
 
+    /**
+     * Build projection of upstream columns onto features of a model.
+     * Model features absent from upstreamColumns are predicted as missing values.
+     * @param modelFileName text model, its feature_names line defines feature order
+     * @param upstreamColumns column names of the rows passed to predictBoosterForProjectedMat
+     */
+    public native FeatureProjection createFeatureProjection(String modelFileName,
+                                                            String[] upstreamColumns);
+
+    public native int featureProjectionFree(FeatureProjection projection);
+
+    /**
+     * Predict directly from wide upstream rows, model features are gathered natively.
+     * @param data row major rowsNumb * projection.getNumbUpstreamColumn() values
+     */
+    public native float[] predictBoosterForProjectedMat(Booster booster,
+                                                        FeatureProjection projection,
+                                                        float[] data,
+                                                        int rowsNumb,
+                                                        PREDICT_TYPE predict_type,
+                                                        long numbIteration);
+
+    /**
+     * Set label, weight or init_score field, LightGBM copies the values
+     */
+    public native int datasetSetFieldFloat(DatesetHandle handle, String fieldName, float[] data);
+
+    /**
+     * Set label, weight or init_score field from doubles, narrowed to float32 natively
+     */
+    public native int datasetSetFieldDouble(DatesetHandle handle, String fieldName, double[] data);
+
+    /**
+     * Set group or group_id field
+     */
+    public native int datasetSetFieldInt(DatesetHandle handle, String fieldName, int[] data);
+
+    /**
+     * Set field straight from a direct buffer in native byte order, read from address 0
+     * @param dataType one of C_API_DTYPE_FLOAT32, C_API_DTYPE_FLOAT64, C_API_DTYPE_INT32
+     */
+    public native int datasetSetFieldDirect(DatesetHandle handle,
+                                            String fieldName,
+                                            ByteBuffer data,
+                                            long numElement,
+                                            int dataType);
+
+    private native ByteBuffer datasetGetFieldBuffer(DatesetHandle handle, String fieldName);
+
+    /**
+     * @return read only direct buffer in native byte order over memory owned by LightGBM,
+     * valid until the dataset is freed or the field is set again
+     */
+    public ByteBuffer datasetGetField(DatesetHandle handle, String fieldName) {
+        return datasetGetFieldBuffer(handle, fieldName).asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+    }
+
+    public FloatBuffer datasetGetFieldFloat(DatesetHandle handle, String fieldName) {
+        return datasetGetField(handle, fieldName).asFloatBuffer();
+    }
+
+    public IntBuffer datasetGetFieldInt(DatesetHandle handle, String fieldName) {
+        return datasetGetField(handle, fieldName).asIntBuffer();
+    }
+
+    /**
+     * Create subset of dataset sharing its bin mappers
+     * @param usedRowIndices ascending row indices of the subset
+     */
+    public native DatesetHandle datasetGetSubset(DatesetHandle handle,
+                                                 int[] usedRowIndices,
+                                                 String parameters);
+
+    /**
+     * k-fold cross validation on subsets of one binned dataset, folds are trained
+     * concurrently and share the core budget
+     * @param numThreads total core budget, &lt;= 0 means all hardware threads
+     * @param seed seed of the row to fold assignment
+     */
+    public native CrossValidationResult crossValidate(DatesetHandle handle,
+                                                      String parameters,
+                                                      int nfold,
+                                                      int numbIteration,
+                                                      int numThreads,
+                                                      long seed);
 
+    public native int boosterFree(Booster booster);
+
+    /**
+     * Merge model of other booster into booster, other booster stays valid
+     */
+    public native int boosterMerge(Booster booster, Booster otherBooster);
+
+    /**
+     * Score one matrix with several boosters in a single native call.
+     * Result is row major, every row holds the outputs of boosters in array order,
+     * num_class floats per booster for normal and raw score prediction.
+     * Every booster may appear only once.
+     * @param numThreads threads over boosters, &lt;= 1 scores sequentially on the calling thread.
+     *                   Extra threads come from a persistent native pool, but each one runs
+     *                   LightGBM's own OpenMP row parallelism too, so more than 1 only pays off
+     *                   for small batches on hosts with spare cores
+     */
+    public native float[] predictBoostersForMat(Booster[] boosters,
+                                                float[] data,
+                                                int rowsNumb,
+                                                int colNumb,
+                                                boolean isRowMajor,
+                                                PREDICT_TYPE predict_type,
+                                                long numbIteration,
+                                                int numThreads);
+
+    public native int boosterResetTrainingData(Booster booster, DatesetHandle trainData);
+
+    public native int boosterResetParameter(Booster booster, String parameters);
+
+    /**
+     * @return 1 when booster cannot split any more, 0 when not
+     */
+    public native int boosterUpdateOneIter(Booster booster);
+
+    /**
+     * Train numbIteration rounds on new data on top of an existing booster.
+     * The training dataset is built from data inside this call, raw scores of the existing booster
+     * on the same rows become its init_score, a fresh booster is trained on it and the existing
+     * trees are merged in front. Cost scales with the new data only. The existing booster is left unchanged.
+     * @param data new rows, binned with parameters
+     * @param label one label per row
+     * @param parameters full training parameters (objective etc.), a loaded booster carries none
+     * @param reference used to align bin mappers with other dataset, null means not used
+     * @return new booster holding the existing and the added trees,
+     * it owns the dataset built from data and boosterFree releases both
+     */
+    public native Booster boosterWarmStart(Booster booster,
+                                           float[] data,
+                                           float[] label,
+                                           int rowsNumb,
+                                           int colNumb,
+                                           boolean isRowMajor,
+                                           String parameters,
+                                           DatesetHandle reference,
+                                           int numbIteration);
+
+    /**
+     * @param numbIteration &lt;= 0 means save all
+     */
+    public native int boosterSaveModel(Booster booster, int numbIteration, String fileName);
+
+    /**
+     * Warm start: load model and add numbIteration rounds trained on new data,
+     * see boosterWarmStart
+     * @return refreshed booster
+     */
+    public Booster warmStart(String modelFileName,
+                             float[] data,
+                             float[] label,
+                             int rowsNumb,
+                             int colNumb,
+                             boolean isRowMajor,
+                             String parameters,
+                             DatesetHandle reference,
+                             int numbIteration) {
+        Booster booster = createBoosterFromModelFile(modelFileName);
+        try {
+            return boosterWarmStart(booster, data, label, rowsNumb, colNumb, isRowMajor,
+                    parameters, reference, numbIteration);
+        } finally {
+            boosterFree(booster);
+        }
+    }
+
+    /**
+     * Create dataset from an Arrow record batch exported through the C Data Interface.
+     * Columns become features in schema order, null feature values become NaN.
+     * The structs are only borrowed, the producer still owns and releases them.
+     * @param schemaAddress address of ArrowSchema of a struct batch
+     * @param arrayAddress address of ArrowArray of the batch
+     * @param labelColumn column stored as label instead of feature, null for none.
+     * A null label row, in the column or the batch, throws LightGBMException
+     * @param reference used to align bin mappers with other dataset, null means not used
+     */
+    public native DatesetHandle createDatasetFromArrow(long schemaAddress,
+                                                       long arrayAddress,
+                                                       String labelColumn,
+                                                       String parameters,
+                                                       DatesetHandle reference);
+
+    /**
+     * Predict an Arrow record batch exported through the C Data Interface,
+     * columns are model features in schema order, null values become NaN.
+     * The structs are only borrowed, the producer still owns and releases them.
+     */
+    public native float[] predictBoosterForArrow(Booster booster,
+                                                 long schemaAddress,
+                                                 long arrayAddress,
+                                                 PREDICT_TYPE predict_type,
+                                                 long numbIteration);
+
+    private native long nativeFootprintOf(long nativePtr);
+
+    /**
+     * Estimated native bytes held by a handle created through this library.
+     * LightGBM sizes are estimates: binned datasets count one byte per value,
+     * boosters count training buffers or model file size plus the trees trained since.
+     */
+    public long nativeFootprint(Booster booster) {
+        return nativeFootprintOf(booster.getNativePtr());
+    }
+
+    public long nativeFootprint(DatesetHandle handle) {
+        return nativeFootprintOf(handle.getNativePtr());
+    }
+
+    public long nativeFootprint(FeatureProjection projection) {
+        return nativeFootprintOf(projection.getNativePtr());
+    }
+
+    /**
+     * @return estimated native bytes of all live handles in this process
+     */
+    public native long totalNativeFootprint();
+
+    /**
+     * Process wide budget of native bytes. Creating a dataset, booster or projection,
+     * or a call whose temporary buffers would exceed it (predict, field narrowing, warm start,
+     * cross validation folds) throws LightGBMException with ERROR_MEMORY_BUDGET.
+     * Trees grown by training are counted afterwards and never fail a training call.
+     * @param bytes &lt;= 0 means unlimited
+     */
+    public native void setNativeMemoryBudget(long bytes);
 
+    public native long getNativeMemoryBudget();
 }
@@ -0,0 +1,25 @@
+
+/**
+ * Thrown by ILightGBMJava when a native call fails.
+ */
+public class LightGBMException extends RuntimeException {
+    /** LightGBM c_api call failed, message is its last error */
+    public static final int ERROR_LIGHTGBM = -1;
+    /** arguments rejected before reaching LightGBM */
+    public static final int ERROR_INVALID_ARGUMENT = -2;
+    /** file could not be read */
+    public static final int ERROR_IO = -3;
+    /** creation refused, it would exceed the native memory budget */
+    public static final int ERROR_MEMORY_BUDGET = -4;
+
+    private final int errorCode;
+
+    public LightGBMException(int errorCode, String message) {
+        super(message);
+        this.errorCode = errorCode;
+    }
+
+    public int getErrorCode() {
+        return errorCode;
+    }
+}
@@ -0,0 +1,129 @@
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileReader;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Checks warmStart against a model trained from scratch.
+ * Usage: WarmStartCheck dataFile [parameters] [numbIteration]
+ * dataFile is a LightGBM example text file with the label in the first column,
+ * its first half trains the existing model, its second half is the new data.
+ * A from-scratch model trained on the new half with the existing raw scores as init_score
+ * must give warm raw scores equal to existing raw scores plus its own raw scores.
+ */
+public class WarmStartCheck {
+
+    private static final double TOLERANCE = 1e-3;
+
+    public static void main(String[] args) throws IOException {
+        String dataFile = args[0];
+        String params = args.length > 1 ? args[1] : "objective=binary num_leaves=15 min_data_in_leaf=20";
+        int numbIteration = args.length > 2 ? Integer.parseInt(args[2]) : 10;
+
+        List<float[]> rows = read(dataFile);
+        int colNumb = rows.get(0).length - 1;
+        int historyNumb = rows.size() / 2;
+        int newNumb = rows.size() - historyNumb;
+        float[] historyLabel = new float[historyNumb];
+        float[] history = features(rows, 0, historyNumb, colNumb, historyLabel);
+        float[] newLabel = new float[newNumb];
+        float[] newData = features(rows, historyNumb, newNumb, colNumb, newLabel);
+
+        ILightGBMJava lib = new ILightGBMJava();
+        File modelFile = File.createTempFile("warm_start", ".txt");
+        modelFile.deleteOnExit();
+
+        DatesetHandle historySet = lib.createDatasetFromMat(history, historyNumb, colNumb, true, params, null);
+        lib.datasetSetFieldFloat(historySet, "label", historyLabel);
+        Booster old = lib.createBooster(historySet, params);
+        for (int i = 0; i < numbIteration; i++) {
+            lib.boosterUpdateOneIter(old);
+        }
+        lib.boosterSaveModel(old, 0, modelFile.getPath());
+        lib.boosterFree(old);
+        lib.datasetFree(historySet);
+
+        Booster warm = lib.warmStart(modelFile.getPath(), newData, newLabel, newNumb, colNumb, true,
+                params, null, numbIteration);
+
+        Booster loaded = lib.createBoosterFromModelFile(modelFile.getPath());
+        float[] oldRaw = lib.predictBoosterForMat(loaded, newData, newNumb, colNumb, true,
+                ILightGBMJava.PREDICT_TYPE.PREDICT_RAW_SCORE, 0);
+        lib.boosterFree(loaded);
+
+        DatesetHandle scratchSet = lib.createDatasetFromMat(newData, newNumb, colNumb, true, params, null);
+        lib.datasetSetFieldFloat(scratchSet, "label", newLabel);
+        lib.datasetSetFieldFloat(scratchSet, "init_score", classMajor(oldRaw, newNumb));
+        Booster scratch = lib.createBooster(scratchSet, params);
+        for (int i = 0; i < numbIteration; i++) {
+            lib.boosterUpdateOneIter(scratch);
+        }
+
+        float[] warmRaw = lib.predictBoosterForMat(warm, newData, newNumb, colNumb, true,
+                ILightGBMJava.PREDICT_TYPE.PREDICT_RAW_SCORE, 0);
+        float[] scratchRaw = lib.predictBoosterForMat(scratch, newData, newNumb, colNumb, true,
+                ILightGBMJava.PREDICT_TYPE.PREDICT_RAW_SCORE, 0);
+
+        double maxDiff = 0;
+        for (int i = 0; i < warmRaw.length; i++) {
+            maxDiff = Math.max(maxDiff, Math.abs(warmRaw[i] - (oldRaw[i] + scratchRaw[i])));
+        }
+        System.out.println(String.format("iterations %d, max raw score difference %.6g", warm.getNumbIteration(), maxDiff));
+
+        lib.boosterFree(scratch);
+        lib.boosterFree(warm);
+        lib.datasetFree(scratchSet);
+
+        if (maxDiff > TOLERANCE || warmRaw.length != oldRaw.length) {
+            System.out.println("FAIL");
+            System.exit(1);
+        }
+        System.out.println("PASS");
+    }
+
+    private static List<float[]> read(String fileName) throws IOException {
+        List<float[]> rows = new ArrayList<float[]>();
+        BufferedReader reader = new BufferedReader(new FileReader(fileName));
+        try {
+            String line;
+            while ((line = reader.readLine()) != null) {
+                if (line.trim().isEmpty()) {
+                    continue;
+                }
+                String[] tokens = line.trim().split("[\\s,]+");
+                float[] row = new float[tokens.length];
+                for (int i = 0; i < tokens.length; i++) {
+                    row[i] = Float.parseFloat(tokens[i]);
+                }
+                rows.add(row);
+            }
+        } finally {
+            reader.close();
+        }
+        return rows;
+    }
+
+    private static float[] features(List<float[]> rows, int from, int rowsNumb, int colNumb, float[] label) {
+        float[] data = new float[rowsNumb * colNumb];
+        for (int i = 0; i < rowsNumb; i++) {
+            float[] row = rows.get(from + i);
+            label[i] = row[0];
+            System.arraycopy(row, 1, data, i * colNumb, colNumb);
+        }
+        return data;
+    }
+
+    /** predictions are row major, init_score is class major */
+    private static float[] classMajor(float[] raw, int rowsNumb) {
+        int numClass = raw.length / rowsNumb;
+        float[] result = new float[raw.length];
+        for (int i = 0; i < rowsNumb; i++) {
+            for (int k = 0; k < numClass; k++) {
+                result[k * rowsNumb + i] = raw[i * numClass + k];
+            }
+        }
+        return result;
+    }
+}
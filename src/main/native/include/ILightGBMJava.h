@@ -15,6 +15,14 @@ extern "C" {
 JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromFile
   (JNIEnv *, jobject, jstring, jstring, jobject);
 
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromBinaryFile
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromBinaryFile
+  (JNIEnv *, jobject, jstring, jstring);
+
 /*
  * Class:     ILightGBMJava
  * Method:    getLastError
@@ -74,10 +82,210 @@ JNIEXPORT jobject JNICALL Java_ILightGBMJava_createBoosterFromModelFile
 /*
  * Class:     ILightGBMJava
  * Method:    predictBoosterForMat
- * Signature: (LBooster;[FIIZJ)[F
+ * Signature: (LBooster;[FIIZLILightGBMJava$PREDICT_TYPE;J)[F
  */
 JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForMat
-  (JNIEnv *, jobject, jobject, jfloatArray, jint, jint, jboolean, jlong);
+  (JNIEnv *, jobject, jobject, jfloatArray, jint, jint, jboolean, jobject, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createFeatureProjection
+ * Signature: (Ljava/lang/String;[Ljava/lang/String;)LFeatureProjection;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createFeatureProjection
+  (JNIEnv *, jobject, jstring, jobjectArray);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    featureProjectionFree
+ * Signature: (LFeatureProjection;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_featureProjectionFree
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoosterForProjectedMat
+ * Signature: (LBooster;LFeatureProjection;[FILILightGBMJava$PREDICT_TYPE;J)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForProjectedMat
+  (JNIEnv *, jobject, jobject, jobject, jfloatArray, jint, jobject, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromMat
+ * Signature: ([FIIZLjava/lang/String;LDatesetHandle;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromMat
+  (JNIEnv *, jobject, jfloatArray, jint, jint, jboolean, jstring, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldFloat
+ * Signature: (LDatesetHandle;Ljava/lang/String;[F)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldFloat
+  (JNIEnv *, jobject, jobject, jstring, jfloatArray);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldDouble
+ * Signature: (LDatesetHandle;Ljava/lang/String;[D)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldDouble
+  (JNIEnv *, jobject, jobject, jstring, jdoubleArray);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldInt
+ * Signature: (LDatesetHandle;Ljava/lang/String;[I)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldInt
+  (JNIEnv *, jobject, jobject, jstring, jintArray);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldDirect
+ * Signature: (LDatesetHandle;Ljava/lang/String;Ljava/nio/ByteBuffer;JI)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldDirect
+  (JNIEnv *, jobject, jobject, jstring, jobject, jlong, jint);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetGetFieldBuffer
+ * Signature: (LDatesetHandle;Ljava/lang/String;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_datasetGetFieldBuffer
+  (JNIEnv *, jobject, jobject, jstring);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetGetSubset
+ * Signature: (LDatesetHandle;[ILjava/lang/String;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_datasetGetSubset
+  (JNIEnv *, jobject, jobject, jintArray, jstring);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    crossValidate
+ * Signature: (LDatesetHandle;Ljava/lang/String;IIIJ)LCrossValidationResult;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_crossValidate
+  (JNIEnv *, jobject, jobject, jstring, jint, jint, jint, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterFree
+ * Signature: (LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterFree
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterMerge
+ * Signature: (LBooster;LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterMerge
+  (JNIEnv *, jobject, jobject, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoostersForMat
+ * Signature: ([LBooster;[FIIZLILightGBMJava$PREDICT_TYPE;JI)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoostersForMat
+  (JNIEnv *, jobject, jobjectArray, jfloatArray, jint, jint, jboolean, jobject, jlong, jint);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterResetTrainingData
+ * Signature: (LBooster;LDatesetHandle;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterResetTrainingData
+  (JNIEnv *, jobject, jobject, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterResetParameter
+ * Signature: (LBooster;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterResetParameter
+  (JNIEnv *, jobject, jobject, jstring);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterUpdateOneIter
+ * Signature: (LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterUpdateOneIter
+  (JNIEnv *, jobject, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterWarmStart
+ * Signature: (LBooster;[F[FIIZLjava/lang/String;LDatesetHandle;I)LBooster;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_boosterWarmStart
+  (JNIEnv *, jobject, jobject, jfloatArray, jfloatArray, jint, jint, jboolean, jstring, jobject, jint);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterSaveModel
+ * Signature: (LBooster;ILjava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterSaveModel
+  (JNIEnv *, jobject, jobject, jint, jstring);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromArrow
+ * Signature: (JJLjava/lang/String;Ljava/lang/String;LDatesetHandle;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromArrow
+  (JNIEnv *, jobject, jlong, jlong, jstring, jstring, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoosterForArrow
+ * Signature: (LBooster;JJLILightGBMJava$PREDICT_TYPE;J)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForArrow
+  (JNIEnv *, jobject, jobject, jlong, jlong, jobject, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    nativeFootprintOf
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_nativeFootprintOf
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    totalNativeFootprint
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_totalNativeFootprint
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    setNativeMemoryBudget
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_ILightGBMJava_setNativeMemoryBudget
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    getNativeMemoryBudget
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_getNativeMemoryBudget
+  (JNIEnv *, jobject);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,229 @@
+#ifndef _ARROW_C_DATA_H_INCLUDED_
+#define _ARROW_C_DATA_H_INCLUDED_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "c_api.h"
+
+// ABI of the Arrow C Data Interface, copied from the specification as it recommends
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char* format;
+  const char* name;
+  const char* metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void** buffers;
+  struct ArrowArray** children;
+  struct ArrowArray* dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray*);
+  // Opaque producer-specific data
+  void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+/*!
+* \brief record batch imported as one column major dense matrix.
+*        Structs are borrowed, release stays with the producer
+*/
+struct ArrowMatrix {
+  int32_t nrow;
+  int32_t ncol;
+  // C_API_DTYPE_FLOAT32 when every feature column fits float32 exactly, C_API_DTYPE_FLOAT64 otherwise
+  int dataType;
+  std::vector<float> float32;
+  std::vector<double> float64;
+  std::vector<float> label;
+
+  const void* data() const {
+    return dataType == C_API_DTYPE_FLOAT32 ? (const void*) float32.data() : (const void*) float64.data();
+  }
+};
+
+inline bool arrowIsValid(const ArrowArray* array, int64_t index) {
+  const uint8_t* validity = array->n_buffers > 0 ? (const uint8_t*) array->buffers[0] : NULL;
+  if (validity == NULL || array->null_count == 0) return true;
+  index += array->offset;
+  return (validity[index >> 3] >> (index & 7)) & 1;
+}
+
+template <typename T, typename V>
+void arrowCopyValues(const ArrowArray* batch, const ArrowArray* column, T* out) {
+  const V* values = (const V*) column->buffers[1] + column->offset + batch->offset;
+  const int64_t length = batch->length;
+  if (batch->null_count == 0 && column->null_count == 0) {
+    for (int64_t row = 0; row < length; ++row) out[row] = (T) values[row];
+    return;
+  }
+  for (int64_t row = 0; row < length; ++row) {
+    bool valid = arrowIsValid(batch, row) && arrowIsValid(column, batch->offset + row);
+    out[row] = valid ? (T) values[row] : (T) NAN;
+  }
+}
+
+/*!
+* \brief whether a batch row is null at batch or column level
+*/
+inline bool arrowHasNull(const ArrowArray* batch, const ArrowArray* column) {
+  if (batch->null_count == 0 && column->null_count == 0) return false;
+  for (int64_t row = 0; row < batch->length; ++row) {
+    if (!arrowIsValid(batch, row) || !arrowIsValid(column, batch->offset + row)) return true;
+  }
+  return false;
+}
+
+template <typename T>
+void arrowCopyBits(const ArrowArray* batch, const ArrowArray* column, T* out) {
+  const uint8_t* values = (const uint8_t*) column->buffers[1];
+  for (int64_t row = 0; row < batch->length; ++row) {
+    const int64_t at = column->offset + batch->offset + row;
+    bool valid = arrowIsValid(batch, row) && arrowIsValid(column, batch->offset + row);
+    out[row] = valid ? (T) ((values[at >> 3] >> (at & 7)) & 1) : (T) NAN;
+  }
+}
+
+/*!
+* \brief copy one primitive child column, rows the child or the batch mark null become NaN
+* \return false when the format is not a supported primitive
+*/
+template <typename T>
+bool arrowCopyColumn(const ArrowSchema* schema, const ArrowArray* batch, const ArrowArray* column, T* out) {
+  const char* format = schema->format;
+  if (std::strlen(format) != 1 || column->n_buffers < 2) return false;
+  switch (format[0]) {
+    case 'f': arrowCopyValues<T, float>(batch, column, out); return true;
+    case 'g': arrowCopyValues<T, double>(batch, column, out); return true;
+    case 'c': arrowCopyValues<T, int8_t>(batch, column, out); return true;
+    case 'C': arrowCopyValues<T, uint8_t>(batch, column, out); return true;
+    case 's': arrowCopyValues<T, int16_t>(batch, column, out); return true;
+    case 'S': arrowCopyValues<T, uint16_t>(batch, column, out); return true;
+    case 'i': arrowCopyValues<T, int32_t>(batch, column, out); return true;
+    case 'I': arrowCopyValues<T, uint32_t>(batch, column, out); return true;
+    case 'l': arrowCopyValues<T, int64_t>(batch, column, out); return true;
+    case 'L': arrowCopyValues<T, uint64_t>(batch, column, out); return true;
+    case 'b': arrowCopyBits<T>(batch, column, out); return true;
+    default: return false;
+  }
+}
+
+/*!
+* \brief upper bound of the bytes importArrowBatch allocates, every column widened to float64
+*/
+inline int64_t arrowImportBytes(const ArrowSchema* schema, const ArrowArray* array) {
+  if (schema == NULL || array == NULL || array->length < 0 || schema->n_children < 0) return 0;
+  return array->length * schema->n_children * (int64_t) sizeof(double);
+}
+
+/*!
+* \brief gather a struct record batch into a column major matrix
+* \param schema schema of the batch, format "+s"
+* \param array the batch
+* \param labelColumn name of the column moved to out->label, empty or NULL for none.
+*        Its rows must not be null, neither in the column nor in the batch
+* \param out imported matrix
+* \param error set when false is returned
+*/
+inline bool importArrowBatch(const ArrowSchema* schema, const ArrowArray* array, const char* labelColumn,
+                             ArrowMatrix* out, std::string* error) {
+  if (schema == NULL || array == NULL || std::strcmp(schema->format, "+s") != 0
+      || schema->n_children != array->n_children) {
+    *error = "expected a struct record batch";
+    return false;
+  }
+  if (array->length > INT32_MAX) {
+    *error = "record batch has more rows than int32 allows";
+    return false;
+  }
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    const char* name = schema->children[i]->name != NULL ? schema->children[i]->name : "";
+    if (schema->children[i]->dictionary != NULL || array->children[i]->dictionary != NULL) {
+      *error = std::string("dictionary encoded column is not supported: ") + name;
+      return false;
+    }
+    // copies read child rows [batch offset, batch offset + batch length)
+    if (array->children[i]->length < array->offset + array->length) {
+      *error = std::string("column is shorter than the record batch: ") + name;
+      return false;
+    }
+  }
+  bool hasLabel = labelColumn != NULL && labelColumn[0] != '\0';
+  int64_t labelIndex = -1;
+  bool wide = false;
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    const char* name = schema->children[i]->name;
+    if (hasLabel && name != NULL && std::strcmp(name, labelColumn) == 0) labelIndex = i;
+    // float32 holds float, 8 and 16 bit integers and booleans exactly, anything wider goes float64
+    const char* format = schema->children[i]->format;
+    wide = wide || (i != labelIndex && std::strchr("fcCsSb", format[0]) == NULL);
+  }
+  if (hasLabel && labelIndex < 0) {
+    *error = std::string("label column not found: ") + labelColumn;
+    return false;
+  }
+
+  out->nrow = (int32_t) array->length;
+  out->ncol = (int32_t) (schema->n_children - (labelIndex < 0 ? 0 : 1));
+  out->dataType = wide ? C_API_DTYPE_FLOAT64 : C_API_DTYPE_FLOAT32;
+  const size_t size = (size_t) out->nrow * out->ncol;
+  if (wide) {
+    out->float64.resize(size);
+  } else {
+    out->float32.resize(size);
+  }
+  int32_t col = 0;
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    bool copied;
+    if (i == labelIndex) {
+      // a NaN label trains silently as a negative or poisons gradients, only features map nulls to NaN
+      if (arrowHasNull(array, array->children[i])) {
+        *error = std::string("label column has null rows: ") + labelColumn;
+        return false;
+      }
+      out->label.resize(out->nrow);
+      copied = arrowCopyColumn(schema->children[i], array, array->children[i], out->label.data());
+    } else if (wide) {
+      copied = arrowCopyColumn(schema->children[i], array, array->children[i],
+                               out->float64.data() + (size_t) col++ * out->nrow);
+    } else {
+      copied = arrowCopyColumn(schema->children[i], array, array->children[i],
+                               out->float32.data() + (size_t) col++ * out->nrow);
+    }
+    if (!copied) {
+      *error = std::string("unsupported arrow format '") + schema->children[i]->format + "' of column "
+               + (schema->children[i]->name != NULL ? schema->children[i]->name : "");
+      return false;
+    }
+  }
+  return true;
+}
+
+#endif
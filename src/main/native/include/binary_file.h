@@ -0,0 +1,25 @@
+#ifndef _BINARY_FILE_H_INCLUDED_
+#define _BINARY_FILE_H_INCLUDED_
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// leading bytes of every file written by LGBM_DatasetSaveBinary, see Dataset::binary_file_token
+#define LIGHTGBM_BINARY_FILE_TOKEN "______LightGBM_Binary_File_Token______\n"
+
+/*!
+* \brief check that file starts with the LightGBM binary dataset token
+* \param fileName file to check
+* \return false when file is missing or is not a binary dataset
+*/
+inline bool isBinaryDatasetFile(const char* fileName) {
+  const size_t tokenSize = std::strlen(LIGHTGBM_BINARY_FILE_TOKEN);
+  std::vector<char> head(tokenSize);
+  std::ifstream file(fileName, std::ios::binary);
+  file.read(head.data(), (std::streamsize) tokenSize);
+  return file.gcount() == (std::streamsize) tokenSize
+         && std::memcmp(head.data(), LIGHTGBM_BINARY_FILE_TOKEN, tokenSize) == 0;
+}
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef _CROSS_VALIDATION_H_INCLUDED_
+#define _CROSS_VALIDATION_H_INCLUDED_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "c_api.h"
+
+/*!
+* \brief per iteration validation metrics aggregated over folds,
+*        mean and stdv are numIteration * numEval, iteration major
+*/
+struct CrossValidationResult {
+  int64_t numEval;
+  int32_t numIteration;
+  std::vector<float> mean;
+  std::vector<float> stdv;
+  std::string error;
+};
+
+/*!
+* \brief drop num_threads and its aliases from 'key1=value1 key2=value2' parameters
+*/
+inline std::string withoutNumThreads(const std::string& params) {
+  static const char* keys[] = {"num_threads", "num_thread", "nthread", "nthreads"};
+  std::istringstream tokens(params);
+  std::string token;
+  std::string out;
+  while (tokens >> token) {
+    std::string key = token.substr(0, token.find('='));
+    bool drop = false;
+    for (const char* numThreads : keys) drop = drop || key == numThreads;
+    if (drop) continue;
+    if (!out.empty()) out += ' ';
+    out += token;
+  }
+  return out;
+}
+
+/*!
+* \return num_class of 'key1=value1 key2=value2' parameters, 1 when absent
+*/
+inline int64_t numClassOf(const std::string& params) {
+  std::istringstream tokens(params);
+  std::string token;
+  int64_t numClass = 1;
+  while (tokens >> token) {
+    size_t eq = token.find('=');
+    std::string key = token.substr(0, eq);
+    if (eq != std::string::npos && (key == "num_class" || key == "num_classes")) {
+      numClass = std::max<int64_t>(1, std::atoll(token.c_str() + eq + 1));
+    }
+  }
+  return numClass;
+}
+
+/*!
+* \brief folds trained at once for a total core budget, <= 0 means all hardware threads
+*/
+inline int32_t foldWorkers(int32_t nfold, int32_t numThreads) {
+  if (numThreads <= 0) numThreads = (int32_t) std::max(1u, std::thread::hardware_concurrency());
+  return std::max(1, std::min(nfold, numThreads));
+}
+
+/*!
+* \brief train one fold on its subsets, out gets numIteration * numEval validation metrics.
+*        An iteration after the booster finished repeats the last metrics
+* \param numEval set to the metric count of the fold booster
+* \return 0 when succeed, -1 when failure happens, error gets LightGBM message of this thread
+*/
+inline int trainFold(DatesetHandle train, DatesetHandle valid, const std::string& params,
+                     int32_t numIteration, int64_t* numEval, std::vector<float>* out, std::string* error) {
+  BoosterHandle booster = NULL;
+  int result = LGBM_BoosterCreate(train, params.c_str(), &booster);
+  if (result == 0) result = LGBM_BoosterAddValidData(booster, valid);
+  if (result == 0) result = LGBM_BoosterGetEvalCounts(booster, numEval);
+  if (result == 0) out->resize((size_t) numIteration * *numEval);
+  int isFinished = 0;
+  for (int32_t iter = 0; result == 0 && iter < numIteration; ++iter) {
+    float* metrics = out->data() + iter * *numEval;
+    if (isFinished) {
+      std::copy(metrics - *numEval, metrics, metrics);
+      continue;
+    }
+    result = LGBM_BoosterUpdateOneIter(booster, &isFinished);
+    int64_t outLen;
+    if (result == 0) result = LGBM_BoosterGetEval(booster, 1, &outLen, metrics);
+  }
+  if (result != 0) *error = LGBM_GetLastError();
+  if (booster != NULL) LGBM_BoosterFree(booster);
+  return result;
+}
+
+/*!
+* \brief k-fold cross validation on subsets of one binned dataset, folds are trained concurrently
+* \param full binned dataset, subsets reuse its bin mappers
+* \param params booster parameters, num_threads is overridden by the per fold core budget
+* \param nfold number of folds
+* \param numIteration boosting rounds per fold
+* \param numThreads total core budget, <= 0 means all hardware threads
+* \param seed seed of the row to fold assignment
+* \param out aggregated metrics
+* \return 0 when succeed, -1 when failure happens
+*/
+inline int crossValidate(DatesetHandle full, const std::string& params, int32_t nfold, int32_t numIteration,
+                         int32_t numThreads, uint64_t seed, CrossValidationResult* out) {
+  out->numEval = 0;
+  out->numIteration = numIteration;
+  int64_t numData;
+  if (nfold < 2 || numIteration <= 0) {
+    out->error = "cross validation needs nfold >= 2 and numIteration > 0";
+    return -1;
+  }
+  if (LGBM_DatasetGetNumData(full, &numData) != 0) {
+    out->error = LGBM_GetLastError();
+    return -1;
+  }
+
+  // shuffled round robin assignment keeps fold sizes within one row
+  std::vector<int32_t> order((size_t) numData);
+  for (int32_t i = 0; i < (int32_t) numData; ++i) order[i] = i;
+  std::mt19937_64 random(seed);
+  std::shuffle(order.begin(), order.end(), random);
+  std::vector<int32_t> foldOf((size_t) numData);
+  for (size_t i = 0; i < order.size(); ++i) foldOf[order[i]] = (int32_t) (i % nfold);
+
+  // subsets are cut on this thread, only training runs concurrently
+  std::vector<DatesetHandle> trainSets(nfold, NULL);
+  std::vector<DatesetHandle> validSets(nfold, NULL);
+  int result = 0;
+  for (int32_t fold = 0; result == 0 && fold < nfold; ++fold) {
+    std::vector<int32_t> trainRows;
+    std::vector<int32_t> validRows;
+    for (int32_t row = 0; row < (int32_t) numData; ++row) {
+      (foldOf[row] == fold ? validRows : trainRows).push_back(row);
+    }
+    result = LGBM_DatasetGetSubset(&full, trainRows.data(), (int32_t) trainRows.size(),
+                                   params.c_str(), &trainSets[fold]);
+    if (result == 0) {
+      result = LGBM_DatasetGetSubset(&full, validRows.data(), (int32_t) validRows.size(),
+                                     params.c_str(), &validSets[fold]);
+    }
+  }
+
+  if (result != 0) out->error = LGBM_GetLastError();
+
+  if (result == 0) {
+    if (numThreads <= 0) numThreads = (int32_t) std::max(1u, std::thread::hardware_concurrency());
+    int32_t numWorkers = foldWorkers(nfold, numThreads);
+    // caller's own num_threads is removed, so the split budget is the only value LightGBM sees
+    std::string foldParams = withoutNumThreads(params) + " num_threads="
+                             + std::to_string(std::max(1, numThreads / numWorkers));
+
+    // every fold booster reports its own metric count, they share params so the counts agree
+    std::vector<int64_t> foldNumEval(nfold, 0);
+    std::vector<std::vector<float>> foldMetrics(nfold);
+    std::vector<int> foldResults(nfold, 0);
+    std::vector<std::string> foldErrors(nfold);
+    std::atomic<int32_t> nextFold(0);
+    std::vector<std::thread> workers;
+    for (int32_t w = 0; w < numWorkers; ++w) {
+      workers.emplace_back([&]() {
+        for (int32_t fold = nextFold++; fold < nfold; fold = nextFold++) {
+          foldResults[fold] = trainFold(trainSets[fold], validSets[fold], foldParams, numIteration,
+                                        &foldNumEval[fold], &foldMetrics[fold], &foldErrors[fold]);
+        }
+      });
+    }
+    for (auto& worker : workers) worker.join();
+
+    for (int32_t fold = 0; result == 0 && fold < nfold; ++fold) {
+      result = foldResults[fold];
+      out->error = foldErrors[fold];
+    }
+    out->numEval = foldNumEval[0];
+    for (int32_t fold = 1; result == 0 && fold < nfold; ++fold) {
+      if (foldNumEval[fold] != out->numEval) {
+        result = -1;
+        out->error = "folds report different metric counts";
+      }
+    }
+    const size_t foldSize = (size_t) numIteration * out->numEval;
+    if (result == 0) {
+      out->mean.assign(foldSize, 0.0f);
+      out->stdv.assign(foldSize, 0.0f);
+      for (size_t i = 0; i < foldSize; ++i) {
+        double sum = 0.0;
+        double sumSquares = 0.0;
+        for (int32_t fold = 0; fold < nfold; ++fold) {
+          double metric = foldMetrics[fold][i];
+          sum += metric;
+          sumSquares += metric * metric;
+        }
+        double mean = sum / nfold;
+        out->mean[i] = (float) mean;
+        out->stdv[i] = (float) std::sqrt(std::max(0.0, sumSquares / nfold - mean * mean));
+      }
+    }
+  }
+
+  for (int32_t fold = 0; fold < nfold; ++fold) {
+    if (trainSets[fold] != NULL) LGBM_DatasetFree(trainSets[fold]);
+    if (validSets[fold] != NULL) LGBM_DatasetFree(validSets[fold]);
+  }
+  return result;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef _FEATURE_PROJECTION_H_INCLUDED_
+#define _FEATURE_PROJECTION_H_INCLUDED_
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+* \brief maps every feature slot of a model to a column of a wider upstream row
+*        columns[i] is the upstream column of model feature i, -1 when upstream does not carry it
+*/
+struct FeatureProjection {
+  std::vector<int32_t> columns;
+  int32_t numUpstreamColumns;
+};
+
+/*!
+* \brief read the feature_names line of a LightGBM text model
+* \param fileName model file
+* \param out feature names in model order
+* \return true when the line was found
+*/
+inline bool readModelFeatureNames(const char* fileName, std::vector<std::string>* out) {
+  std::ifstream model(fileName);
+  std::string line;
+  const std::string prefix = "feature_names=";
+  while (std::getline(model, line)) {
+    if (line.compare(0, prefix.size(), prefix) != 0) continue;
+    std::istringstream names(line.substr(prefix.size()));
+    std::string name;
+    while (names >> name) out->push_back(name);
+    return true;
+  }
+  return false;
+}
+
+/*!
+* \brief build projection of upstream columns onto model features
+* \param modelFeatures feature names in model order
+* \param upstreamColumns column names of upstream rows
+* \param out created projection
+*/
+inline void buildFeatureProjection(const std::vector<std::string>& modelFeatures,
+                                   const std::vector<std::string>& upstreamColumns,
+                                   FeatureProjection* out) {
+  std::unordered_map<std::string, int32_t> upstreamIndex;
+  for (size_t i = 0; i < upstreamColumns.size(); ++i) {
+    upstreamIndex.emplace(upstreamColumns[i], (int32_t) i);
+  }
+  out->numUpstreamColumns = (int32_t) upstreamColumns.size();
+  out->columns.resize(modelFeatures.size());
+  for (size_t i = 0; i < modelFeatures.size(); ++i) {
+    auto it = upstreamIndex.find(modelFeatures[i]);
+    out->columns[i] = it == upstreamIndex.end() ? -1 : it->second;
+  }
+}
+
+/*!
+* \brief gather model features from row major upstream rows into row major model rows,
+*        features missing upstream are set to NaN
+* \param projection projection to apply
+* \param upstream nrow * numUpstreamColumns values
+* \param nrow number of rows
+* \param out nrow * columns.size() values
+*/
+inline void projectRows(const FeatureProjection& projection, const float* upstream, int32_t nrow, float* out) {
+  const size_t numFeatures = projection.columns.size();
+  const int32_t* columns = projection.columns.data();
+  for (int32_t row = 0; row < nrow; ++row) {
+    const float* src = upstream + (size_t) row * projection.numUpstreamColumns;
+    float* dst = out + (size_t) row * numFeatures;
+    for (size_t i = 0; i < numFeatures; ++i) {
+      dst[i] = columns[i] < 0 ? NAN : src[columns[i]];
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _JNI_ERROR_H_INCLUDED_
+#define _JNI_ERROR_H_INCLUDED_
+
+#include "c_api.h"
+
+// error codes of LightGBMException, keep in sync with LightGBMException.java
+#define JNI_ERROR_LIGHTGBM          (-1)
+#define JNI_ERROR_INVALID_ARGUMENT  (-2)
+#define JNI_ERROR_IO                (-3)
+#define JNI_ERROR_MEMORY_BUDGET     (-4)
+
+// resolved once in JNI_OnLoad, so failures never look classes up.
+// Function local statics keep a single instance however many units include this header
+inline jclass& exceptionClass()
+{
+    static jclass c = NULL;
+    return c;
+}
+
+inline jmethodID& exceptionConstructor()
+{
+    static jmethodID m = NULL;
+    return m;
+}
+
+inline bool initErrorChannel(JNIEnv *env)
+{
+    jclass c = env->FindClass("LightGBMException");
+    if (c == NULL) return false;
+    exceptionClass() = (jclass) env->NewGlobalRef(c);
+    env->DeleteLocalRef(c);
+    exceptionConstructor() = env->GetMethodID(exceptionClass(), "<init>", "(ILjava/lang/String;)V");
+    return exceptionConstructor() != NULL;
+}
+
+inline void releaseErrorChannel(JNIEnv *env)
+{
+    if (exceptionClass() != NULL) env->DeleteGlobalRef(exceptionClass());
+    exceptionClass() = NULL;
+    exceptionConstructor() = NULL;
+}
+
+/*
+ * raise LightGBMException in the calling java thread, the native caller must return right after
+ */
+inline void throwLightGBMException(JNIEnv *env, int code, const char *message)
+{
+    jstring jMessage = env->NewStringUTF(message);
+    jobject exception = env->NewObject(exceptionClass(), exceptionConstructor(), (jint) code, jMessage);
+    if (exception != NULL) env->Throw((jthrowable) exception);
+}
+
+/*
+ * raise the error LightGBM recorded for this thread by its last failed call
+ */
+inline void throwLastError(JNIEnv *env)
+{
+    throwLightGBMException(env, JNI_ERROR_LIGHTGBM, LGBM_GetLastError());
+}
+
+/*
+ * \return true when result is 0, otherwise raises LightGBMException
+ */
+inline bool checkResult(JNIEnv *env, int result)
+{
+    if (result == 0) return true;
+    throwLastError(env);
+    return false;
+}
+
+#endif
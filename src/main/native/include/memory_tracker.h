@@ -0,0 +1,219 @@
+#ifndef _MEMORY_TRACKER_H_INCLUDED_
+#define _MEMORY_TRACKER_H_INCLUDED_
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "c_api.h"
+
+/*!
+* \brief native bytes held per handle and an optional process wide budget.
+*        Creation reserves its estimate first, so a budget breach fails before anything is allocated
+*/
+class MemoryTracker {
+public:
+  MemoryTracker() : total_(0), budget_(0) {}
+
+  /*!
+  * \brief account bytes ahead of an allocation
+  * \return false when the budget would be exceeded, nothing is accounted then
+  */
+  bool reserve(int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_ > 0 && total_ + bytes > budget_) return false;
+    total_ += bytes;
+    return true;
+  }
+
+  /*!
+  * \brief undo reserve of an allocation that failed or was temporary
+  */
+  void cancel(int64_t reserved) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_ -= reserved;
+  }
+
+  /*!
+  * \brief replace reservation by the size estimated after creation and attach it to handle
+  */
+  void commit(const void* handle, int64_t reserved, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_ += bytes - reserved;
+    sizes_[handle] = bytes;
+  }
+
+  /*!
+  * \brief grow or shrink footprint of a live handle
+  */
+  void add(const void* handle, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_ += bytes;
+    sizes_[handle] += bytes;
+  }
+
+  /*!
+  * \brief settle reservation of an operation that rebuilt a live handle, bytes replace its footprint
+  */
+  void replace(const void* handle, int64_t reserved, int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t& size = sizes_[handle];
+    total_ += bytes - reserved - size;
+    size = bytes;
+  }
+
+  void untrack(const void* handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sizes_.find(handle);
+    if (it == sizes_.end()) return;
+    total_ -= it->second;
+    sizes_.erase(it);
+  }
+
+  int64_t footprint(const void* handle) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sizes_.find(handle);
+    return it == sizes_.end() ? 0 : it->second;
+  }
+
+  int64_t total() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+  }
+
+  /*!
+  * \param bytes budget, <= 0 means unlimited. Lowering it never frees live handles
+  */
+  void setBudget(int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = bytes > 0 ? bytes : 0;
+  }
+
+  int64_t budget() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<const void*, int64_t> sizes_;
+  int64_t total_;
+  int64_t budget_;
+};
+
+/*!
+* \brief reservation of buffers living for one call, cancelled when it goes out of scope
+*/
+class TransientReservation {
+public:
+  explicit TransientReservation(MemoryTracker* tracker) : tracker_(tracker), bytes_(0) {}
+  ~TransientReservation() { tracker_->cancel(bytes_); }
+
+  /*!
+  * \return false when the budget would be exceeded, earlier reservations stay held
+  */
+  bool reserve(int64_t bytes) {
+    if (!tracker_->reserve(bytes)) return false;
+    bytes_ += bytes;
+    return true;
+  }
+
+private:
+  TransientReservation(const TransientReservation&);
+  TransientReservation& operator=(const TransientReservation&);
+
+  MemoryTracker* tracker_;
+  int64_t bytes_;
+};
+
+/*!
+* \brief binned dataset estimate: one byte bin per feature value plus float label per row
+*/
+inline int64_t estimateDatasetBytes(int64_t numData, int64_t numFeature) {
+  return numData * (numFeature + (int64_t) sizeof(float));
+}
+
+inline int64_t estimateDatasetBytes(DatesetHandle handle) {
+  int64_t numData;
+  int64_t numFeature;
+  if (LGBM_DatasetGetNumData(handle, &numData) != 0 || LGBM_DatasetGetNumFeature(handle, &numFeature) != 0) {
+    return 0;
+  }
+  return estimateDatasetBytes(numData, numFeature);
+}
+
+/*!
+* \brief training booster estimate: score, gradient and hessian per row and class,
+*        trees are counted separately by estimateTreeBytes
+*/
+inline int64_t estimateTrainingBoosterBytes(BoosterHandle booster, DatesetHandle trainData) {
+  int64_t numData;
+  int64_t numClass;
+  if (LGBM_DatasetGetNumData(trainData, &numData) != 0 || LGBM_BoosterGetNumClasses(booster, &numClass) != 0) {
+    return 0;
+  }
+  return numData * numClass * (int64_t) (sizeof(double) + 2 * sizeof(float));
+}
+
+// one tree of the default 31 leaves: per node split, threshold, gain and count arrays, per leaf value and count
+#define ESTIMATED_TREE_BYTES 4096
+
+/*!
+* \brief model estimate of numIteration boosting rounds, one tree per class each
+*/
+inline int64_t estimateTreeBytes(BoosterHandle booster, int64_t numIteration) {
+  int64_t numClass;
+  if (LGBM_BoosterGetNumClasses(booster, &numClass) != 0) {
+    return 0;
+  }
+  return numIteration * numClass * ESTIMATED_TREE_BYTES;
+}
+
+/*!
+* \return size of file in bytes, 0 when it cannot be read
+*/
+inline int64_t fileBytes(const char* fileName) {
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  std::streamoff size = file ? (std::streamoff) file.tellg() : 0;
+  return size > 0 ? (int64_t) size : 0;
+}
+
+/*!
+* \brief binned dataset estimate of a text file, rows and columns taken from its first megabyte.
+*        Columns are counted on the first line and include the label, sparse formats count their tokens
+*/
+inline int64_t estimateTextDatasetBytes(const char* fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file) return 0;
+  std::vector<char> sample(1 << 20);
+  file.read(sample.data(), (std::streamsize) sample.size());
+  const int64_t sampled = (int64_t) file.gcount();
+  if (sampled <= 0) return 0;
+
+  int64_t lines = 0;
+  int64_t columns = 0;
+  bool inToken = false;
+  for (int64_t i = 0; i < sampled; ++i) {
+    const char c = sample[i];
+    if (c == '\n') {
+      ++lines;
+      continue;
+    }
+    if (lines > 0) continue;
+    const bool separator = c == ' ' || c == '\t' || c == ',' || c == '\r';
+    if (!separator && !inToken) ++columns;
+    inToken = !separator;
+  }
+  int64_t rows;
+  if (sampled < (int64_t) sample.size()) {
+    rows = lines + (sample[sampled - 1] != '\n' ? 1 : 0);
+  } else {
+    // whole lines of the sample scaled to the file size
+    rows = (int64_t) ((double) fileBytes(fileName) * std::max<int64_t>(lines, 1) / sampled);
+  }
+  return estimateDatasetBytes(rows, columns);
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef _MULTI_PREDICT_H_INCLUDED_
+#define _MULTI_PREDICT_H_INCLUDED_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "c_api.h"
+
+/*!
+* \brief persistent worker threads shared by all multi booster predictions.
+*        Threads are started on first use and only grow up to the largest request,
+*        so steady state scoring creates no threads and no new OpenMP teams
+*/
+class PredictPool {
+public:
+  PredictPool() : stop_(false) {}
+
+  ~PredictPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+  }
+
+  /*!
+  * \brief run task on numTasks pool threads plus the calling thread, return when all finished
+  */
+  void run(int32_t numTasks, const std::function<void()>& task) {
+    std::mutex doneMutex;
+    std::condition_variable done;
+    int32_t pending = numTasks;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      while ((int32_t) workers_.size() < numTasks) {
+        workers_.emplace_back([this]() { loop(); });
+      }
+      for (int32_t i = 0; i < numTasks; ++i) {
+        tasks_.push_back([&]() {
+          task();
+          std::lock_guard<std::mutex> doneLock(doneMutex);
+          if (--pending == 0) done.notify_one();
+        });
+      }
+    }
+    wake_.notify_all();
+    task();
+    std::unique_lock<std::mutex> doneLock(doneMutex);
+    done.wait(doneLock, [&]() { return pending == 0; });
+  }
+
+private:
+  void loop() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        if (stop_ && tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+  bool stop_;
+};
+
+/*!
+* \brief score one dense matrix with several boosters,
+*        out is row major nrow * sum(widths), the columns of booster m follow those of booster m - 1.
+*        Every booster must appear once, LightGBM swaps a booster's predictor on each call
+* \param boosters distinct boosters to evaluate
+* \param widths output floats per row of every booster
+* \param data input matrix shared by all boosters
+* \param numThreads threads over boosters, <= 1 scores sequentially on the calling thread
+* \param pool pool supplying the numThreads - 1 extra threads
+* \param out pre-allocated result
+* \param error LightGBM message of the first failed booster
+* \return 0 when succeed, -1 when failure happens
+*/
+inline int predictForMatMulti(const std::vector<BoosterHandle>& boosters, const std::vector<int64_t>& widths,
+                              const float* data, int32_t nrow, int32_t ncol, int isRowMajor, int predictType,
+                              int64_t numIteration, int32_t numThreads, PredictPool* pool,
+                              float* out, std::string* error) {
+  const int32_t numBooster = (int32_t) boosters.size();
+  std::vector<int64_t> offsets(numBooster, 0);
+  int64_t totalWidth = 0;
+  for (int32_t m = 0; m < numBooster; ++m) {
+    offsets[m] = totalWidth;
+    totalWidth += widths[m];
+  }
+
+  std::vector<int> results(numBooster, 0);
+  std::vector<std::string> errors(numBooster);
+  std::atomic<int32_t> nextBooster(0);
+  auto work = [&]() {
+    std::vector<float> single;
+    for (int32_t m = nextBooster++; m < numBooster; m = nextBooster++) {
+      // an exception escaping a pool thread would terminate the JVM
+      try {
+        single.resize((size_t) (widths[m] * nrow));
+      } catch (const std::bad_alloc&) {
+        results[m] = -1;
+        errors[m] = "cannot allocate prediction buffer";
+        continue;
+      }
+      int64_t outLen;
+      results[m] = LGBM_BoosterPredictForMat(boosters[m], data, C_API_DTYPE_FLOAT32, nrow, ncol, isRowMajor,
+                                             predictType, numIteration, &outLen, single.data());
+      if (results[m] != 0) {
+        errors[m] = LGBM_GetLastError();
+        continue;
+      }
+      // columns of different boosters are disjoint, so workers scatter without locking
+      for (int32_t row = 0; row < nrow; ++row) {
+        std::copy(single.begin() + row * widths[m], single.begin() + (row + 1) * widths[m],
+                  out + row * totalWidth + offsets[m]);
+      }
+    }
+  };
+
+  int32_t numWorkers = std::min(numBooster, numThreads);
+  if (numWorkers <= 1) {
+    work();
+  } else {
+    pool->run(numWorkers - 1, work);
+  }
+
+  for (int32_t m = 0; m < numBooster; ++m) {
+    if (results[m] != 0) {
+      *error = errors[m];
+      return results[m];
+    }
+  }
+  return 0;
+}
+
+#endif
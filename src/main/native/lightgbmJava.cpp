@@ -1,36 +1,247 @@
 #include <vector>
+#include <algorithm>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 #include "c_api.h"
 #include "ILightGBMJava.h"
 #include "handle.h"
+#include "jni_error.h"
+#include "feature_projection.h"
+#include "binary_file.h"
+#include "cross_validation.h"
+#include "multi_predict.h"
+#include "arrow_c_data.h"
+#include "memory_tracker.h"
 
 
+// hot path ids, resolved once in JNI_OnLoad
+static jmethodID enumOrdinal = NULL;
+static jfieldID boosterIterationField = NULL;
+
+/*
+ * resolve ids used on every predict and training call
+ */
+static bool initJavaIds(JNIEnv * env){
+    jclass clsEnum = env->FindClass("java/lang/Enum");
+    jclass clsBooster = env->FindClass("Booster");//TODO move class name to constants in h
+    if(clsEnum == NULL || clsBooster == NULL){
+        return false;
+    }
+    enumOrdinal = env->GetMethodID(clsEnum,"ordinal","()I");
+    boosterIterationField = env->GetFieldID(clsBooster,"numbIteration","J");
+    env->DeleteLocalRef(clsEnum);
+    env->DeleteLocalRef(clsBooster);
+    return enumOrdinal != NULL && boosterIterationField != NULL;
+}
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved){
+    JNIEnv* env;
+    if(vm->GetEnv((void**) &env,JNI_VERSION_1_6) != JNI_OK || !initErrorChannel(env) || !initJavaIds(env)){
+        return JNI_ERR;
+    }
+    return JNI_VERSION_1_6;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM* vm, void* reserved){
+    JNIEnv* env;
+    if(vm->GetEnv((void**) &env,JNI_VERSION_1_6) == JNI_OK){
+        releaseErrorChannel(env);
+    }
+}
+
+static MemoryTracker memoryTracker;
+
+/*
+ * reserve bytes against the native memory budget, raises LightGBMException when it is exhausted
+ */
+static bool reserveNativeMemory(JNIEnv * env, int64_t bytes){
+    if(memoryTracker.reserve(bytes)){
+        return true;
+    }
+    throwLightGBMException(env,JNI_ERROR_MEMORY_BUDGET,"native memory budget exhausted");
+    return false;
+}
+
+/*
+ * reserve bytes of a buffer released before the call returns, raises LightGBMException when the budget is exhausted
+ */
+static bool reserveTransientMemory(JNIEnv * env, TransientReservation* transient, int64_t bytes){
+    if(transient->reserve(bytes)){
+        return true;
+    }
+    throwLightGBMException(env,JNI_ERROR_MEMORY_BUDGET,"native memory budget exhausted");
+    return false;
+}
+
+/*
+ * settle reservation of a dataset creation, created dataset keeps its own estimate
+ */
+static void commitDataset(int result, DatesetHandle handle, int64_t reserved){
+    if(result == 0){
+        memoryTracker.commit(handle,reserved,estimateDatasetBytes(handle));
+    }else{
+        memoryTracker.cancel(reserved);
+    }
+}
+
+/*
+ * ordinal of ILightGBMJava.PREDICT_TYPE matches C_API_PREDICT_* constants
+ */
+static int getPredictType(JNIEnv * env, jobject jPredictType){
+    return (int) env->CallIntMethod(jPredictType,enumOrdinal);
+}
+
+/*
+ * number of floats LGBM_BoosterPredictForMat writes for nrow rows, -1 on failure
+ */
+static int64_t getPredictResultSize(BoosterHandle booster, int32_t nrow, int predictType, int64_t numIteration){
+    int64_t numClass;
+    if(LGBM_BoosterGetNumClasses(booster,&numClass) != 0){
+        return -1;
+    }
+    int64_t size = numClass * nrow;
+    if(predictType == C_API_PREDICT_LEAF_INDEX){
+        int64_t numModelIteration;
+        if(LGBM_BoosterGetCurrentIteration(booster,&numModelIteration) != 0){
+            return -1;
+        }
+        if(numIteration <= 0 || numIteration > numModelIteration){
+            numIteration = numModelIteration;
+        }
+        size *= numIteration;
+    }
+    return size;
+}
+
+
+/*
+ * check that java array holds an nrow * ncol matrix, raises LightGBMException when not
+ */
+static bool checkMatrixLength(JNIEnv * env, jarray jdata, jint jNrow, jint jNcol){
+    if(jNrow < 0 || jNcol < 0){
+        throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"rowsNumb and colNumb must not be negative");
+        return false;
+    }
+    if((int64_t) env->GetArrayLength(jdata) < (int64_t) jNrow * jNcol){
+        throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"data is shorter than rowsNumb * colNumb");
+        return false;
+    }
+    return true;
+}
+
+/*
+ * wrap native dataset into java DatesetHandle
+ */
+static jobject newJavaDataset(JNIEnv * env, DatesetHandle handle){
+    jclass clsDataHandler = env->FindClass("DatesetHandle");//TODO move class name to constants in h
+    jmethodID constructorDataHandler = env->GetMethodID(clsDataHandler,"<init>","(J)V");
+    return env->NewObject(clsDataHandler,constructorDataHandler,(jlong) handle);
+}
+
+/*
+ * wrap native booster into java Booster
+ */
+static jobject newJavaBooster(JNIEnv * env, BoosterHandle booster){
+    jclass clsBooster = env->FindClass("Booster");//TODO move class name to constants in h
+    jmethodID constructorBooster = env->GetMethodID(clsBooster,"<init>","(J)V");
+    return env->NewObject(clsBooster,constructorBooster,(jlong) booster);
+}
+
+//training datasets built natively for a booster, LightGBM keeps using them until the booster is freed
+static std::mutex ownedTrainDataMutex;
+static std::unordered_map<BoosterHandle,DatesetHandle> ownedTrainData;
+
+/*
+ * free the training dataset built for booster, if any
+ */
+static void freeOwnedTrainData(BoosterHandle booster){
+    DatesetHandle handle = NULL;
+    {
+        std::lock_guard<std::mutex> lock(ownedTrainDataMutex);
+        auto it = ownedTrainData.find(booster);
+        if(it == ownedTrainData.end()){
+            return;
+        }
+        handle = it->second;
+        ownedTrainData.erase(it);
+    }
+    LGBM_DatasetFree(handle);
+    memoryTracker.untrack(handle);
+}
+
 JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromFile
   (JNIEnv * env, jobject object, jstring jFileName, jstring jParams, jobject jDataHandler){
     const char *fileName = env->GetStringUTFChars(jFileName,0);
     const char *params = env->GetStringUTFChars(jParams,0);
     
     DatesetHandle out;
+    DatesetHandle reference;
     DatesetHandle* dh;
     
     //Get native datahandler if it exist
     if(!(env->IsSameObject(jDataHandler,NULL))){
-        *dh = getHandle<DatesetHandle>(env,jDataHandler);
+        reference = getHandle<DatesetHandle>(env,jDataHandler);
+        dh = &reference;
     }
     else dh=NULL;
     
+    //sampling the file only matters against a budget, the committed footprint comes from the handle
+    int64_t reserved = memoryTracker.budget() > 0 ? estimateTextDatasetBytes(fileName) : 0;
+    if(!reserveNativeMemory(env,reserved)){
+        env->ReleaseStringUTFChars(jFileName,fileName);
+        env->ReleaseStringUTFChars(jParams,params);
+        return NULL;
+    }
     
     int result = LGBM_DatasetCreateFromFile(fileName,params,dh,&out);
+    commitDataset(result,out,reserved);
 
     jobject jResult=NULL;
-    if(result == 0){
-        jclass clsDataHandler = env->FindClass("DatesetHandle");//TODO move class name to constants in h
-        jmethodID constructorDataHandler = env->GetMethodID(clsDataHandler,"<init>","(J)V");
-        jlong jOut = (jlong) out;
-        jResult = env->NewObject(clsDataHandler,constructorDataHandler,jOut);
+    if(checkResult(env,result)){
+        jResult = newJavaDataset(env,out);
     }
     
     
+    env->ReleaseStringUTFChars(jFileName,fileName);
+    env->ReleaseStringUTFChars(jParams,params);
+
+    return jResult;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromBinaryFile
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromBinaryFile
+  (JNIEnv * env, jobject obj, jstring jFileName, jstring jParams){
+    const char *fileName = env->GetStringUTFChars(jFileName,0);
+
+    //the file loader silently parses anything else as text, so refuse it up front
+    if(!isBinaryDatasetFile(fileName)){
+        env->ReleaseStringUTFChars(jFileName,fileName);
+        throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"file is not a LightGBM binary dataset");
+        return NULL;
+    }
+    const char *params = env->GetStringUTFChars(jParams,0);
+
+    int64_t reserved = fileBytes(fileName);
+    if(!reserveNativeMemory(env,reserved)){
+        env->ReleaseStringUTFChars(jFileName,fileName);
+        env->ReleaseStringUTFChars(jParams,params);
+        return NULL;
+    }
+
+    DatesetHandle out;
+    int result = LGBM_DatasetCreateFromFile(fileName,params,NULL,&out);
+    commitDataset(result,out,reserved);
+
+    jobject jResult=NULL;
+    if(checkResult(env,result)){
+        jResult = newJavaDataset(env,out);
+    }
+
     env->ReleaseStringUTFChars(jFileName,fileName);
     env->ReleaseStringUTFChars(jParams,params);
 
@@ -44,12 +255,8 @@ JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromFile
  */
 JNIEXPORT jstring JNICALL Java_ILightGBMJava_getLastError
   (JNIEnv *env, jobject obj){
-      jstring result;
-      const char* errorStr = LGBM_GetLastError();
-      result = env->NewStringUTF(errorStr);
-      free((char*)errorStr);
-      return result;
-      
+      //message buffer is owned by LightGBM, it must not be freed here
+      return env->NewStringUTF(LGBM_GetLastError());
   }
 
 /*
@@ -60,7 +267,11 @@ JNIEXPORT jstring JNICALL Java_ILightGBMJava_getLastError
 JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetFree
   (JNIEnv * env, jobject obj, jobject jDataHandler){
       DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandler);
-      return LGBM_DatasetFree(handle);
+      int result = LGBM_DatasetFree(handle);
+      if(checkResult(env,result)){
+          memoryTracker.untrack(handle);
+      }
+      return result;
     }
 
 /*
@@ -77,6 +288,7 @@ JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSaveBinary
       
       env->ReleaseStringUTFChars(jFileName,fileName);
       
+      checkResult(env,result);
       return result;
   }
 
@@ -92,7 +304,7 @@ JNIEXPORT jlong JNICALL Java_ILightGBMJava_datasetGetNumData
       
       int result = LGBM_DatasetGetNumData(handle,&out);
       
-      if(result == 0){
+      if(checkResult(env,result)){
           return out;
       }else{
           return -1;
@@ -111,7 +323,7 @@ JNIEXPORT jlong JNICALL Java_ILightGBMJava_datasetGetNumFeature
       
       int result = LGBM_DatasetGetNumFeature(handle,&out);
       
-      if(result == 0){
+      if(checkResult(env,result)){
           return out;
       }else{
           return -1;
@@ -126,16 +338,27 @@ JNIEXPORT jobject JNICALL Java_ILightGBMJava_createBooster
       jobject jResult;
       
       handle = getHandle<DatesetHandle>(env,jHandler);
+      int64_t numData;
+      if(!checkResult(env,LGBM_DatasetGetNumData(handle,&numData))){
+          return NULL;
+      }
+      //single class guess until the booster can report its class count
+      int64_t reserved = numData * (int64_t) (sizeof(double) + 2 * sizeof(float));
+      if(!reserveNativeMemory(env,reserved)){
+          return NULL;
+      }
       params = env->GetStringUTFChars(jParams,0);
       
       int result = LGBM_BoosterCreate(handle,params,&booster);
+      if(result == 0){
+          memoryTracker.commit(booster,reserved,estimateTrainingBoosterBytes(booster,handle));
+      }else{
+          memoryTracker.cancel(reserved);
+      }
       
       jResult = NULL;
-      if(result == 0){
-          jclass clsBooster = env->FindClass("Booster");//TODO move class name to constants in h
-          jmethodID constructorBooster = env->GetMethodID(clsBooster,"<init>","(J)V");
-          jlong jOut = (jlong) booster;
-          jResult = env->NewObject(clsBooster,constructorBooster,jOut);
+      if(checkResult(env,result)){
+          jResult = newJavaBooster(env,booster);
         }
       
       
@@ -158,16 +381,23 @@ JNIEXPORT jobject JNICALL Java_ILightGBMJava_createBoosterFromModelFile
     
     
     
+    //loaded trees take about as much memory as their text form
+    int64_t reserved = fileBytes(fileName);
+    if(!reserveNativeMemory(env,reserved)){
+        env->ReleaseStringUTFChars(jFileName,fileName);
+        return NULL;
+    }
+    
     int result = LGBM_BoosterCreateFromModelfile(fileName,&outNumbIter, &out);
-    jobject jResult=NULL;
     if(result == 0){
-        jclass clsBooster = env->FindClass("Booster");//TODO move class name to constants in h
-        jmethodID constructorBooster = env->GetMethodID(clsBooster,"<init>","(J)V");
-        jlong jOut = (jlong) out;
-        jResult = env->NewObject(clsBooster,constructorBooster,jOut);
-        
-        jfieldID jIterField = env->GetFieldID(clsBooster, "numbIteration", "J");
-        env->SetLongField(jResult, jIterField, (jlong) outNumbIter);
+        memoryTracker.commit(out,reserved,reserved);
+    }else{
+        memoryTracker.cancel(reserved);
+    }
+    jobject jResult=NULL;
+    if(checkResult(env,result)){
+        jResult = newJavaBooster(env,out);
+        env->SetLongField(jResult,boosterIterationField,(jlong) outNumbIter);
     }
     
     
@@ -181,7 +411,7 @@ JNIEXPORT jobject JNICALL Java_ILightGBMJava_createBoosterFromModelFile
 /*
  * Class:     ILightGBMJava
  * Method:    predictBoosterForMat
- * Signature: (LBooster;[FIIZJ)[F
+ * Signature: (LBooster;[FIIZLILightGBMJava$PREDICT_TYPE;J)[F
  */
 JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForMat
   (JNIEnv * env,
@@ -191,28 +421,918 @@ JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForMat
     jint jNrow,
     jint jNcol,
     jboolean jIsRowMajor,
-    jint predictType,
-    jlong jNumIteration,
-    jint jMemSize)
+    jobject jPredictType,
+    jlong jNumIteration)
     {
+      if(!checkMatrixLength(env,jdata,jNrow,jNcol)){
+          return NULL;
+      }
       BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
-      float* data = env->GetFloatArrayElements(jdata,0);
+      int predictType = getPredictType(env,jPredictType);
       
+      int64_t memSize = getPredictResultSize(booster,(int32_t) jNrow,predictType,(int64_t) jNumIteration);
+      if(memSize < 0){
+          throwLastError(env);
+          return NULL;
+      }
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,memSize * (int64_t) sizeof(float))){
+          return NULL;
+      }
+      std::vector<float> outResult(memSize);
       int64_t outLen;
-      int memSize = (int)jMemSize;
-      float* outResult = new float[memSize];
+      float* data = env->GetFloatArrayElements(jdata,0);
       int result = LGBM_BoosterPredictForMat(booster,data,C_API_DTYPE_FLOAT32,(int) jNrow, (int)jNcol,
-                                    (int)jIsRowMajor,(int) predictType,(int64_t) jNumIteration, &outLen,outResult);
+                                    (int)jIsRowMajor,predictType,(int64_t) jNumIteration, &outLen,outResult.data());
+      env->ReleaseFloatArrayElements(jdata,data,JNI_ABORT);
+      if(!checkResult(env,result)){
+          return NULL;
+      }
                                 
       jfloatArray jResult = env->NewFloatArray(outLen);
-      if(result==0){
-        env->SetFloatArrayRegion(jResult,0,outLen,outResult);
+      env->SetFloatArrayRegion(jResult,0,outLen,outResult.data());
+      return jResult;
       }
-                                    
-      
-      env->ReleaseFloatArrayElements(jdata,data,0);
-      
-      
-      
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createFeatureProjection
+ * Signature: (Ljava/lang/String;[Ljava/lang/String;)LFeatureProjection;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createFeatureProjection
+  (JNIEnv * env, jobject obj, jstring jModelFileName, jobjectArray jUpstreamColumns){
+      const char *modelFileName = env->GetStringUTFChars(jModelFileName,0);
+
+      //c_api has no feature name getter, so names are taken from the model file itself
+      std::vector<std::string> modelFeatures;
+      bool found = readModelFeatureNames(modelFileName,&modelFeatures);
+      env->ReleaseStringUTFChars(jModelFileName,modelFileName);
+      if(!found){
+          throwLightGBMException(env,JNI_ERROR_IO,"cannot read feature_names from model file");
+          return NULL;
+      }
+
+      jsize numUpstream = env->GetArrayLength(jUpstreamColumns);
+      std::vector<std::string> upstreamColumns(numUpstream);
+      for(jsize i = 0; i < numUpstream; ++i){
+          jstring jColumn = (jstring) env->GetObjectArrayElement(jUpstreamColumns,i);
+          const char *column = env->GetStringUTFChars(jColumn,0);
+          upstreamColumns[i] = column;
+          env->ReleaseStringUTFChars(jColumn,column);
+          env->DeleteLocalRef(jColumn);
+      }
+
+      int64_t reserved = (int64_t) (sizeof(FeatureProjection) + modelFeatures.size() * sizeof(int32_t));
+      if(!reserveNativeMemory(env,reserved)){
+          return NULL;
+      }
+      FeatureProjection* projection = new FeatureProjection();
+      buildFeatureProjection(modelFeatures,upstreamColumns,projection);
+      memoryTracker.commit(projection,reserved,reserved);
+
+      jclass clsProjection = env->FindClass("FeatureProjection");//TODO move class name to constants in h
+      jmethodID constructorProjection = env->GetMethodID(clsProjection,"<init>","(JII)V");
+      return env->NewObject(clsProjection,constructorProjection,(jlong) projection,
+                            (jint) projection->columns.size(),(jint) projection->numUpstreamColumns);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    featureProjectionFree
+ * Signature: (LFeatureProjection;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_featureProjectionFree
+  (JNIEnv * env, jobject obj, jobject jProjection){
+      FeatureProjection* projection = getHandle<FeatureProjection>(env,jProjection);
+      memoryTracker.untrack(projection);
+      delete projection;
+      setHandle<FeatureProjection>(env,jProjection,NULL);
+      return 0;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoosterForProjectedMat
+ * Signature: (LBooster;LFeatureProjection;[FILILightGBMJava$PREDICT_TYPE;J)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForProjectedMat
+  (JNIEnv * env,
+    jobject obj,
+    jobject jBooster,
+    jobject jProjection,
+    jfloatArray jdata,
+    jint jNrow,
+    jobject jPredictType,
+    jlong jNumIteration)
+    {
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      FeatureProjection* projection = getHandle<FeatureProjection>(env,jProjection);
+      if(projection == NULL){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"feature projection is already freed");
+          return NULL;
+      }
+      if(jNrow < 0){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"rowsNumb must not be negative");
+          return NULL;
+      }
+      int predictType = getPredictType(env,jPredictType);
+      int32_t nrow = (int32_t) jNrow;
+      int32_t ncol = (int32_t) projection->columns.size();
+
+      if((int64_t) env->GetArrayLength(jdata) < (int64_t) nrow * projection->numUpstreamColumns){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"data is shorter than rowsNumb upstream rows");
+          return NULL;
+      }
+
+      int64_t memSize = getPredictResultSize(booster,nrow,predictType,(int64_t) jNumIteration);
+      if(memSize < 0){
+          throwLastError(env);
+          return NULL;
+      }
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,((int64_t) nrow * ncol + memSize) * (int64_t) sizeof(float))){
+          return NULL;
+      }
+
+      //gather model columns straight from the pinned upstream rows, LightGBM only sees the narrow copy
+      std::vector<float> projected((size_t) nrow * ncol);
+      float* data = (float*) env->GetPrimitiveArrayCritical(jdata,0);
+      projectRows(*projection,data,nrow,projected.data());
+      env->ReleasePrimitiveArrayCritical(jdata,data,JNI_ABORT);
+
+      std::vector<float> outResult(memSize);
+      int64_t outLen;
+      int result = LGBM_BoosterPredictForMat(booster,projected.data(),C_API_DTYPE_FLOAT32,nrow,ncol,
+                                    1,predictType,(int64_t) jNumIteration,&outLen,outResult.data());
+      if(!checkResult(env,result)){
+          return NULL;
+      }
+
+      jfloatArray jResult = env->NewFloatArray(outLen);
+      env->SetFloatArrayRegion(jResult,0,outLen,outResult.data());
+      return jResult;
+    }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromMat
+ * Signature: ([FIIZLjava/lang/String;LDatesetHandle;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromMat
+  (JNIEnv * env, jobject obj, jfloatArray jdata, jint jNrow, jint jNcol, jboolean jIsRowMajor,
+    jstring jParams, jobject jReference){
+      if(!checkMatrixLength(env,jdata,jNrow,jNcol)){
+          return NULL;
+      }
+      int64_t reserved = estimateDatasetBytes((int64_t) jNrow,(int64_t) jNcol);
+      if(!reserveNativeMemory(env,reserved)){
+          return NULL;
+      }
+      const char *params = env->GetStringUTFChars(jParams,0);
+
+      DatesetHandle out;
+      DatesetHandle reference;
+      DatesetHandle* dh = NULL;
+      if(!(env->IsSameObject(jReference,NULL))){
+          reference = getHandle<DatesetHandle>(env,jReference);
+          dh = &reference;
+      }
+
+      float* data = env->GetFloatArrayElements(jdata,0);
+      int result = LGBM_DatasetCreateFromMat(data,C_API_DTYPE_FLOAT32,(int32_t) jNrow,(int32_t) jNcol,
+                                            (int) jIsRowMajor,params,dh,&out);
+      env->ReleaseFloatArrayElements(jdata,data,JNI_ABORT);
+      commitDataset(result,out,reserved);
+
+      jobject jResult=NULL;
+      if(checkResult(env,result)){
+          jResult = newJavaDataset(env,out);
+      }
+
+      env->ReleaseStringUTFChars(jParams,params);
+
       return jResult;
+  }
+
+/*
+ * set field from pinned primitive array, LightGBM copies it into dataset metadata
+ */
+static jint setFieldFromArray(JNIEnv * env, jobject jDataHandle, jstring jFieldName, jarray jdata, int dataType){
+    DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+    const char *fieldName = env->GetStringUTFChars(jFieldName,0);
+    jsize numElement = env->GetArrayLength(jdata);
+
+    void* data = env->GetPrimitiveArrayCritical(jdata,0);
+    int result = LGBM_DatasetSetField(handle,fieldName,data,(int64_t) numElement,dataType);
+    env->ReleasePrimitiveArrayCritical(jdata,data,JNI_ABORT);
+
+    env->ReleaseStringUTFChars(jFieldName,fieldName);
+    checkResult(env,result);
+    return result;
+}
+
+/*
+ * c_api takes float fields as float32 only, narrow float64 once on native side
+ */
+static int setFieldFromDoubles(DatesetHandle handle, const char* fieldName, const double* data, int64_t numElement){
+    std::vector<float> narrowed(data,data + numElement);
+    return LGBM_DatasetSetField(handle,fieldName,narrowed.data(),numElement,C_API_DTYPE_FLOAT32);
+}
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldFloat
+ * Signature: (LDatesetHandle;Ljava/lang/String;[F)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldFloat
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jFieldName, jfloatArray jdata){
+      return setFieldFromArray(env,jDataHandle,jFieldName,jdata,C_API_DTYPE_FLOAT32);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldInt
+ * Signature: (LDatesetHandle;Ljava/lang/String;[I)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldInt
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jFieldName, jintArray jdata){
+      return setFieldFromArray(env,jDataHandle,jFieldName,jdata,C_API_DTYPE_INT32);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldDouble
+ * Signature: (LDatesetHandle;Ljava/lang/String;[D)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldDouble
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jFieldName, jdoubleArray jdata){
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      const char *fieldName = env->GetStringUTFChars(jFieldName,0);
+      jsize numElement = env->GetArrayLength(jdata);
+      //narrowed float copy
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,(int64_t) numElement * (int64_t) sizeof(float))){
+          env->ReleaseStringUTFChars(jFieldName,fieldName);
+          return -1;
+      }
+
+      double* data = (double*) env->GetPrimitiveArrayCritical(jdata,0);
+      int result = setFieldFromDoubles(handle,fieldName,data,(int64_t) numElement);
+      env->ReleasePrimitiveArrayCritical(jdata,data,JNI_ABORT);
+
+      env->ReleaseStringUTFChars(jFieldName,fieldName);
+      checkResult(env,result);
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetSetFieldDirect
+ * Signature: (LDatesetHandle;Ljava/lang/String;Ljava/nio/ByteBuffer;JI)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_datasetSetFieldDirect
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jFieldName, jobject jBuffer, jlong jNumElement, jint jDataType){
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      if(jDataType != C_API_DTYPE_FLOAT32 && jDataType != C_API_DTYPE_FLOAT64 && jDataType != C_API_DTYPE_INT32){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"dataType must be C_API_DTYPE_FLOAT32, C_API_DTYPE_FLOAT64 or C_API_DTYPE_INT32");
+          return -1;
+      }
+      if(jNumElement < 0){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"numElement must not be negative");
+          return -1;
       }
+      const void* data = env->GetDirectBufferAddress(jBuffer);
+      int64_t elementSize = jDataType == C_API_DTYPE_FLOAT64 ? 8 : 4;
+      if(data == NULL || (int64_t) jNumElement * elementSize > (int64_t) env->GetDirectBufferCapacity(jBuffer)){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"data must be a direct buffer holding numElement values");
+          return -1;
+      }
+
+      TransientReservation transient(&memoryTracker);
+      if(jDataType == C_API_DTYPE_FLOAT64
+         && !reserveTransientMemory(env,&transient,(int64_t) jNumElement * (int64_t) sizeof(float))){
+          return -1;
+      }
+
+      const char *fieldName = env->GetStringUTFChars(jFieldName,0);
+      int result;
+      if(jDataType == C_API_DTYPE_FLOAT64){
+          result = setFieldFromDoubles(handle,fieldName,(const double*) data,(int64_t) jNumElement);
+      }else{
+          result = LGBM_DatasetSetField(handle,fieldName,data,(int64_t) jNumElement,(int) jDataType);
+      }
+      env->ReleaseStringUTFChars(jFieldName,fieldName);
+      checkResult(env,result);
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetGetFieldBuffer
+ * Signature: (LDatesetHandle;Ljava/lang/String;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_datasetGetFieldBuffer
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jFieldName){
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      const char *fieldName = env->GetStringUTFChars(jFieldName,0);
+
+      int64_t outLen;
+      const void* outPtr;
+      int outType;
+      int result = LGBM_DatasetGetField(handle,fieldName,&outLen,&outPtr,&outType);
+      env->ReleaseStringUTFChars(jFieldName,fieldName);
+      if(!checkResult(env,result)){
+          return NULL;
+      }
+
+      //no copy, the buffer views memory LightGBM owns until the dataset is freed or the field is set again
+      static char emptyField;
+      void* address = outLen > 0 ? const_cast<void*>(outPtr) : &emptyField;
+      int64_t elementSize = outType == C_API_DTYPE_FLOAT64 || outType == C_API_DTYPE_INT64 ? 8 : 4;
+      return env->NewDirectByteBuffer(address,(jlong) (outLen * elementSize));
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    datasetGetSubset
+ * Signature: (LDatesetHandle;[ILjava/lang/String;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_datasetGetSubset
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jintArray jUsedRowIndices, jstring jParams){
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      jsize numUsedRow = env->GetArrayLength(jUsedRowIndices);
+      int64_t numFeature;
+      if(!checkResult(env,LGBM_DatasetGetNumFeature(handle,&numFeature))){
+          return NULL;
+      }
+      int64_t reserved = estimateDatasetBytes((int64_t) numUsedRow,numFeature);
+      if(!reserveNativeMemory(env,reserved)){
+          return NULL;
+      }
+      const char *params = env->GetStringUTFChars(jParams,0);
+
+      DatesetHandle out;
+      int32_t* usedRowIndices = (int32_t*) env->GetPrimitiveArrayCritical(jUsedRowIndices,0);
+      int result = LGBM_DatasetGetSubset(&handle,usedRowIndices,(int32_t) numUsedRow,params,&out);
+      env->ReleasePrimitiveArrayCritical(jUsedRowIndices,usedRowIndices,JNI_ABORT);
+      commitDataset(result,out,reserved);
+
+      jobject jResult=NULL;
+      if(checkResult(env,result)){
+          jResult = newJavaDataset(env,out);
+      }
+
+      env->ReleaseStringUTFChars(jParams,params);
+
+      return jResult;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    crossValidate
+ * Signature: (LDatesetHandle;Ljava/lang/String;IIIJ)LCrossValidationResult;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_crossValidate
+  (JNIEnv * env, jobject obj, jobject jDataHandle, jstring jParams, jint jNfold, jint jNumIteration,
+    jint jNumThreads, jlong jSeed){
+      if(jNfold < 2 || jNumIteration <= 0){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"cross validation needs nfold >= 2 and numbIteration > 0");
+          return NULL;
+      }
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      int64_t numData;
+      if(!checkResult(env,LGBM_DatasetGetNumData(handle,&numData))){
+          return NULL;
+      }
+      const char *params = env->GetStringUTFChars(jParams,0);
+      //every row lands in nfold subsets, held until the call returns,
+      //and each concurrent fold booster holds training state for at most every row
+      int64_t numWorkers = foldWorkers((int32_t) jNfold,(int32_t) jNumThreads);
+      int64_t reserved = estimateDatasetBytes(handle) * jNfold
+                         + numWorkers * numData * numClassOf(params) * (int64_t) (sizeof(double) + 2 * sizeof(float));
+      if(!reserveNativeMemory(env,reserved)){
+          env->ReleaseStringUTFChars(jParams,params);
+          return NULL;
+      }
+
+      CrossValidationResult cv;
+      int result = crossValidate(handle,params,(int32_t) jNfold,(int32_t) jNumIteration,
+                                 (int32_t) jNumThreads,(uint64_t) jSeed,&cv);
+      memoryTracker.cancel(reserved);
+
+      env->ReleaseStringUTFChars(jParams,params);
+      if(result != 0){
+          //fold errors were recorded on worker threads, LightGBM's message of this thread is unrelated
+          throwLightGBMException(env,JNI_ERROR_LIGHTGBM,cv.error.c_str());
+          return NULL;
+      }
+
+      jfloatArray jMean = env->NewFloatArray((jsize) cv.mean.size());
+      env->SetFloatArrayRegion(jMean,0,(jsize) cv.mean.size(),cv.mean.data());
+      jfloatArray jStdv = env->NewFloatArray((jsize) cv.stdv.size());
+      env->SetFloatArrayRegion(jStdv,0,(jsize) cv.stdv.size(),cv.stdv.data());
+
+      jclass clsResult = env->FindClass("CrossValidationResult");//TODO move class name to constants in h
+      jmethodID constructorResult = env->GetMethodID(clsResult,"<init>","([F[FII)V");
+      return env->NewObject(clsResult,constructorResult,jMean,jStdv,(jint) cv.numEval,(jint) cv.numIteration);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterFree
+ * Signature: (LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterFree
+  (JNIEnv * env, jobject obj, jobject jBooster){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      int result = LGBM_BoosterFree(booster);
+      if(checkResult(env,result)){
+          memoryTracker.untrack(booster);
+          freeOwnedTrainData(booster);
+          setHandle<BoosterHandle>(env,jBooster,NULL);
+      }
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterMerge
+ * Signature: (LBooster;LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterMerge
+  (JNIEnv * env, jobject obj, jobject jBooster, jobject jOtherBooster){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      BoosterHandle otherBooster = getHandle<BoosterHandle>(env,jOtherBooster);
+      if(booster == NULL || otherBooster == NULL){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"booster is already freed");
+          return -1;
+      }
+      //merged trees are copied, booster grows by the other booster's footprint
+      int64_t merged = memoryTracker.footprint(otherBooster);
+      if(!reserveNativeMemory(env,merged)){
+          return -1;
+      }
+      int result = LGBM_BoosterMerge(booster,otherBooster);
+      memoryTracker.cancel(merged);
+      if(checkResult(env,result)){
+          memoryTracker.add(booster,merged);
+      }
+      return result;
+  }
+
+static PredictPool predictPool;
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoostersForMat
+ * Signature: ([LBooster;[FIIZLILightGBMJava$PREDICT_TYPE;JI)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoostersForMat
+  (JNIEnv * env,
+    jobject obj,
+    jobjectArray jBoosters,
+    jfloatArray jdata,
+    jint jNrow,
+    jint jNcol,
+    jboolean jIsRowMajor,
+    jobject jPredictType,
+    jlong jNumIteration,
+    jint jNumThreads)
+    {
+      if(!checkMatrixLength(env,jdata,jNrow,jNcol)){
+          return NULL;
+      }
+      int predictType = getPredictType(env,jPredictType);
+      int32_t nrow = (int32_t) jNrow;
+      jsize numBooster = env->GetArrayLength(jBoosters);
+
+      std::vector<BoosterHandle> boosters(numBooster);
+      for(jsize m = 0; m < numBooster; ++m){
+          jobject jBooster = env->GetObjectArrayElement(jBoosters,m);
+          boosters[m] = getHandle<BoosterHandle>(env,jBooster);
+          env->DeleteLocalRef(jBooster);
+          if(boosters[m] == NULL){
+              throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"boosters must not contain a freed booster");
+              return NULL;
+          }
+      }
+      //one booster scored twice at once would race on the predictor LightGBM swaps per call
+      std::vector<BoosterHandle> sorted(boosters);
+      std::sort(sorted.begin(),sorted.end());
+      if(std::adjacent_find(sorted.begin(),sorted.end()) != sorted.end()){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"boosters must not contain the same booster twice");
+          return NULL;
+      }
+
+      std::vector<int64_t> widths(numBooster);
+      int64_t totalWidth = 0;
+      int64_t maxWidth = 0;
+      for(jsize m = 0; m < numBooster; ++m){
+          int64_t memSize = getPredictResultSize(boosters[m],nrow,predictType,(int64_t) jNumIteration);
+          if(memSize < 0){
+              throwLastError(env);
+              return NULL;
+          }
+          widths[m] = nrow > 0 ? memSize / nrow : 0;
+          totalWidth += widths[m];
+          maxWidth = std::max(maxWidth,widths[m]);
+      }
+      //every worker holds one booster's output before scattering it into the result
+      int64_t numWorkers = std::max<int64_t>(std::min<int64_t>(numBooster,jNumThreads),1);
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,(totalWidth + numWorkers * maxWidth) * nrow * (int64_t) sizeof(float))){
+          return NULL;
+      }
+
+      //input is pinned once and shared by every booster
+      std::vector<float> outResult((size_t) (totalWidth * nrow));
+      std::string error;
+      float* data = env->GetFloatArrayElements(jdata,0);
+      int result = predictForMatMulti(boosters,widths,data,nrow,(int32_t) jNcol,(int) jIsRowMajor,predictType,
+                                      (int64_t) jNumIteration,(int32_t) jNumThreads,&predictPool,
+                                      outResult.data(),&error);
+      env->ReleaseFloatArrayElements(jdata,data,JNI_ABORT);
+      if(result != 0){
+          throwLightGBMException(env,JNI_ERROR_LIGHTGBM,error.c_str());
+          return NULL;
+      }
+
+      jfloatArray jResult = env->NewFloatArray((jsize) outResult.size());
+      env->SetFloatArrayRegion(jResult,0,(jsize) outResult.size(),outResult.data());
+      return jResult;
+    }
+
+/*
+ * refresh numbIteration of java Booster from native booster, raises LightGBMException on failure
+ */
+static bool updateJavaBoosterIteration(JNIEnv * env, jobject jBooster, BoosterHandle booster){
+    int64_t numIteration;
+    if(!checkResult(env,LGBM_BoosterGetCurrentIteration(booster,&numIteration))){
+        return false;
+    }
+    env->SetLongField(jBooster,boosterIterationField,(jlong) numIteration);
+    return true;
+}
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterResetTrainingData
+ * Signature: (LBooster;LDatesetHandle;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterResetTrainingData
+  (JNIEnv * env, jobject obj, jobject jBooster, jobject jDataHandle){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      DatesetHandle handle = getHandle<DatesetHandle>(env,jDataHandle);
+      //training state is rebuilt for the new rows, trees are kept
+      int64_t reserved = estimateTrainingBoosterBytes(booster,handle);
+      if(!reserveNativeMemory(env,reserved)){
+          return -1;
+      }
+      int result = LGBM_BoosterResetTrainingData(booster,handle);
+      int64_t numIteration;
+      if(result == 0 && LGBM_BoosterGetCurrentIteration(booster,&numIteration) == 0){
+          memoryTracker.replace(booster,reserved,reserved + estimateTreeBytes(booster,numIteration));
+      }else{
+          memoryTracker.cancel(reserved);
+      }
+      checkResult(env,result);
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterResetParameter
+ * Signature: (LBooster;Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterResetParameter
+  (JNIEnv * env, jobject obj, jobject jBooster, jstring jParams){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      const char *params = env->GetStringUTFChars(jParams,0);
+
+      int result = LGBM_BoosterResetParameter(booster,params);
+
+      env->ReleaseStringUTFChars(jParams,params);
+      checkResult(env,result);
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterUpdateOneIter
+ * Signature: (LBooster;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterUpdateOneIter
+  (JNIEnv * env, jobject obj, jobject jBooster){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      int isFinished;
+
+      int result = LGBM_BoosterUpdateOneIter(booster,&isFinished);
+      if(!checkResult(env,result)){
+          return -1;
+      }
+      //a finished round keeps no trees
+      if(!isFinished){
+          memoryTracker.add(booster,estimateTreeBytes(booster,1));
+      }
+      if(!updateJavaBoosterIteration(env,jBooster,booster)){
+          return -1;
+      }
+      return isFinished;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterWarmStart
+ * Signature: (LBooster;[F[FIIZLjava/lang/String;LDatesetHandle;I)LBooster;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_boosterWarmStart
+  (JNIEnv * env, jobject obj, jobject jBooster, jfloatArray jdata, jfloatArray jLabel, jint jNrow, jint jNcol,
+    jboolean jIsRowMajor, jstring jParams, jobject jReference, jint jNumIteration){
+      if(!checkMatrixLength(env,jdata,jNrow,jNcol)){
+          return NULL;
+      }
+      if(env->GetArrayLength(jLabel) != jNrow){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"label must hold rowsNumb values");
+          return NULL;
+      }
+      BoosterHandle oldBooster = getHandle<BoosterHandle>(env,jBooster);
+      if(oldBooster == NULL){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,"booster is already freed");
+          return NULL;
+      }
+      int32_t nrow = (int32_t) jNrow;
+      int32_t ncol = (int32_t) jNcol;
+      int64_t numClass;
+      if(!checkResult(env,LGBM_BoosterGetNumClasses(oldBooster,&numClass))){
+          return NULL;
+      }
+      //raw scores and their class major copy
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,2 * numClass * nrow * (int64_t) sizeof(float))){
+          return NULL;
+      }
+      int64_t datasetReserved = estimateDatasetBytes((int64_t) nrow,(int64_t) ncol);
+      if(!reserveNativeMemory(env,datasetReserved)){
+          return NULL;
+      }
+      DatesetHandle reference;
+      DatesetHandle* dh = NULL;
+      if(!(env->IsSameObject(jReference,NULL))){
+          reference = getHandle<DatesetHandle>(env,jReference);
+          dh = &reference;
+      }
+      const char *params = env->GetStringUTFChars(jParams,0);
+
+      //the dataset and the old booster's scores come from the same pinned rows, so init_score always matches them
+      DatesetHandle handle = NULL;
+      BoosterHandle booster = NULL;
+      int errorCode = JNI_ERROR_LIGHTGBM;
+      std::string error;
+      std::vector<float> rawScore((size_t) (numClass * nrow));
+      int64_t outLen;
+      float* data = env->GetFloatArrayElements(jdata,0);
+      int result = LGBM_DatasetCreateFromMat(data,C_API_DTYPE_FLOAT32,nrow,ncol,(int) jIsRowMajor,params,dh,&handle);
+      commitDataset(result,handle,datasetReserved);
+      //a loaded booster has no objective and replays no trees on ResetTrainingData,
+      //so old trees enter as init_score of a fresh booster and are merged back afterwards
+      if(result == 0){
+          result = LGBM_BoosterPredictForMat(oldBooster,data,C_API_DTYPE_FLOAT32,nrow,ncol,(int) jIsRowMajor,
+                                             C_API_PREDICT_RAW_SCORE,0,&outLen,rawScore.data());
+      }
+      env->ReleaseFloatArrayElements(jdata,data,JNI_ABORT);
+      if(result == 0){
+          float* label = env->GetFloatArrayElements(jLabel,0);
+          result = LGBM_DatasetSetField(handle,"label",label,nrow,C_API_DTYPE_FLOAT32);
+          env->ReleaseFloatArrayElements(jLabel,label,JNI_ABORT);
+      }
+      if(result == 0){
+          //predictions are row major, init_score is class major
+          std::vector<float> initScore(rawScore.size());
+          for(int32_t row = 0; row < nrow; ++row){
+              for(int64_t k = 0; k < numClass; ++k){
+                  initScore[k * nrow + row] = rawScore[row * numClass + k];
+              }
+          }
+          result = LGBM_DatasetSetField(handle,"init_score",initScore.data(),(int64_t) initScore.size(),
+                                        C_API_DTYPE_FLOAT32);
+      }
+
+      int64_t boosterReserved = (int64_t) nrow * numClass * (int64_t) (sizeof(double) + 2 * sizeof(float));
+      if(result == 0 && !memoryTracker.reserve(boosterReserved)){
+          result = -1;
+          errorCode = JNI_ERROR_MEMORY_BUDGET;
+          error = "native memory budget exhausted";
+      }else if(result == 0){
+          result = LGBM_BoosterCreate(handle,params,&booster);
+          if(result == 0){
+              memoryTracker.commit(booster,boosterReserved,estimateTrainingBoosterBytes(booster,handle));
+          }else{
+              memoryTracker.cancel(boosterReserved);
+          }
+      }
+      env->ReleaseStringUTFChars(jParams,params);
+
+      int isFinished = 0;
+      int64_t numTrained = 0;
+      for(int32_t iter = 0; result == 0 && !isFinished && iter < (int32_t) jNumIteration; ++iter){
+          result = LGBM_BoosterUpdateOneIter(booster,&isFinished);
+          numTrained += result == 0 && !isFinished ? 1 : 0;
+      }
+      //merge puts the other booster's trees first, so the model reads old trees then new ones
+      if(result == 0){
+          result = LGBM_BoosterMerge(booster,oldBooster);
+      }
+      if(result != 0){
+          if(error.empty()){
+              error = LGBM_GetLastError();
+          }
+          if(booster != NULL){
+              LGBM_BoosterFree(booster);
+              memoryTracker.untrack(booster);
+          }
+          if(handle != NULL){
+              LGBM_DatasetFree(handle);
+              memoryTracker.untrack(handle);
+          }
+          throwLightGBMException(env,errorCode,error.c_str());
+          return NULL;
+      }
+      memoryTracker.add(booster,estimateTreeBytes(booster,numTrained) + memoryTracker.footprint(oldBooster));
+      {
+          std::lock_guard<std::mutex> lock(ownedTrainDataMutex);
+          ownedTrainData[booster] = handle;
+      }
+
+      jobject jResult = newJavaBooster(env,booster);
+      if(!updateJavaBoosterIteration(env,jResult,booster)){
+          LGBM_BoosterFree(booster);
+          memoryTracker.untrack(booster);
+          freeOwnedTrainData(booster);
+          return NULL;
+      }
+      return jResult;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    boosterSaveModel
+ * Signature: (LBooster;ILjava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_ILightGBMJava_boosterSaveModel
+  (JNIEnv * env, jobject obj, jobject jBooster, jint jNumIteration, jstring jFileName){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      const char *fileName = env->GetStringUTFChars(jFileName,0);
+
+      int result = LGBM_BoosterSaveModel(booster,(int) jNumIteration,fileName);
+
+      env->ReleaseStringUTFChars(jFileName,fileName);
+      checkResult(env,result);
+      return result;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    createDatasetFromArrow
+ * Signature: (JJLjava/lang/String;Ljava/lang/String;LDatesetHandle;)LDatesetHandle;
+ */
+JNIEXPORT jobject JNICALL Java_ILightGBMJava_createDatasetFromArrow
+  (JNIEnv * env, jobject obj, jlong jSchemaAddress, jlong jArrayAddress, jstring jLabelColumn,
+    jstring jParams, jobject jReference){
+      const ArrowSchema* schema = reinterpret_cast<const ArrowSchema*>(jSchemaAddress);
+      const ArrowArray* array = reinterpret_cast<const ArrowArray*>(jArrayAddress);
+
+      //the gather copy lives until the dataset is built
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,arrowImportBytes(schema,array))){
+          return NULL;
+      }
+      ArrowMatrix matrix;
+      std::string error;
+      const char *labelColumn = env->IsSameObject(jLabelColumn,NULL) ? NULL : env->GetStringUTFChars(jLabelColumn,0);
+      bool imported = importArrowBatch(schema,array,labelColumn,&matrix,&error);
+      if(labelColumn != NULL){
+          env->ReleaseStringUTFChars(jLabelColumn,labelColumn);
+      }
+      if(!imported){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,error.c_str());
+          return NULL;
+      }
+
+      DatesetHandle out;
+      DatesetHandle reference;
+      DatesetHandle* dh = NULL;
+      if(!(env->IsSameObject(jReference,NULL))){
+          reference = getHandle<DatesetHandle>(env,jReference);
+          dh = &reference;
+      }
+
+      int64_t reserved = estimateDatasetBytes(matrix.nrow,matrix.ncol);
+      if(!reserveNativeMemory(env,reserved)){
+          return NULL;
+      }
+      const char *params = env->GetStringUTFChars(jParams,0);
+      int result = LGBM_DatasetCreateFromMat(matrix.data(),matrix.dataType,matrix.nrow,matrix.ncol,
+                                            0,params,dh,&out);
+      env->ReleaseStringUTFChars(jParams,params);
+      if(result == 0 && !matrix.label.empty()){
+          result = LGBM_DatasetSetField(out,"label",matrix.label.data(),(int64_t) matrix.label.size(),
+                                        C_API_DTYPE_FLOAT32);
+          if(result != 0){
+              std::string error = LGBM_GetLastError();
+              LGBM_DatasetFree(out);
+              memoryTracker.cancel(reserved);
+              throwLightGBMException(env,JNI_ERROR_LIGHTGBM,error.c_str());
+              return NULL;
+          }
+      }
+      commitDataset(result,out,reserved);
+      if(!checkResult(env,result)){
+          return NULL;
+      }
+      return newJavaDataset(env,out);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    predictBoosterForArrow
+ * Signature: (LBooster;JJLILightGBMJava$PREDICT_TYPE;J)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_ILightGBMJava_predictBoosterForArrow
+  (JNIEnv * env, jobject obj, jobject jBooster, jlong jSchemaAddress, jlong jArrayAddress,
+    jobject jPredictType, jlong jNumIteration){
+      BoosterHandle booster = getHandle<BoosterHandle>(env,jBooster);
+      int predictType = getPredictType(env,jPredictType);
+      const ArrowSchema* schema = reinterpret_cast<const ArrowSchema*>(jSchemaAddress);
+      const ArrowArray* array = reinterpret_cast<const ArrowArray*>(jArrayAddress);
+
+      TransientReservation transient(&memoryTracker);
+      if(!reserveTransientMemory(env,&transient,arrowImportBytes(schema,array))){
+          return NULL;
+      }
+      ArrowMatrix matrix;
+      std::string error;
+      if(!importArrowBatch(schema,array,NULL,&matrix,&error)){
+          throwLightGBMException(env,JNI_ERROR_INVALID_ARGUMENT,error.c_str());
+          return NULL;
+      }
+
+      int64_t memSize = getPredictResultSize(booster,matrix.nrow,predictType,(int64_t) jNumIteration);
+      if(memSize < 0){
+          throwLastError(env);
+          return NULL;
+      }
+      if(!reserveTransientMemory(env,&transient,memSize * (int64_t) sizeof(float))){
+          return NULL;
+      }
+      std::vector<float> outResult(memSize);
+      int64_t outLen;
+      int result = LGBM_BoosterPredictForMat(booster,matrix.data(),matrix.dataType,matrix.nrow,matrix.ncol,
+                                    0,predictType,(int64_t) jNumIteration,&outLen,outResult.data());
+      if(!checkResult(env,result)){
+          return NULL;
+      }
+
+      jfloatArray jResult = env->NewFloatArray(outLen);
+      env->SetFloatArrayRegion(jResult,0,outLen,outResult.data());
+      return jResult;
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    nativeFootprintOf
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_nativeFootprintOf
+  (JNIEnv * env, jobject obj, jlong jNativePtr){
+      return (jlong) memoryTracker.footprint(reinterpret_cast<const void*>(jNativePtr));
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    totalNativeFootprint
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_totalNativeFootprint
+  (JNIEnv * env, jobject obj){
+      return (jlong) memoryTracker.total();
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    setNativeMemoryBudget
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_ILightGBMJava_setNativeMemoryBudget
+  (JNIEnv * env, jobject obj, jlong jBytes){
+      memoryTracker.setBudget((int64_t) jBytes);
+  }
+
+/*
+ * Class:     ILightGBMJava
+ * Method:    getNativeMemoryBudget
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_ILightGBMJava_getNativeMemoryBudget
+  (JNIEnv * env, jobject obj){
+      return (jlong) memoryTracker.budget();
+  }
@@ -0,0 +1,119 @@
+#include <functional>
+#include <vector>
+#include <cstdio>
+#include "arrow_c_data.h"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+  if (!(condition)) { std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); ++failures; }
+
+static bool same(double actual, double expected) {
+  return std::isnan(expected) ? std::isnan(actual) : actual == expected;
+}
+
+static ArrowSchema column(const char* format, const char* name) {
+  ArrowSchema schema = {format, name, NULL, ARROW_FLAG_NULLABLE, 0, NULL, NULL, NULL, NULL};
+  return schema;
+}
+
+static ArrowArray array(int64_t length, int64_t nullCount, const void** buffers) {
+  ArrowArray array = {length, nullCount, 0, 2, 0, buffers, NULL, NULL, NULL, NULL};
+  return array;
+}
+
+/*
+ * batch rows 1..3 of four row columns a (float32), y (float32) and b (int32):
+ * a has row 1 null, the batch has row 3 null, b forces float64
+ */
+static void testImport() {
+  float a[] = {1, 2, 3, 4};
+  float y[] = {0, 1, 0, 1};
+  int32_t b[] = {10, 20, 30, 40};
+  uint8_t aValidity = 0xD;      // 1101
+  uint8_t batchValidity = 0x7;  // 0111
+  const void* aBuffers[] = {&aValidity, a};
+  const void* yBuffers[] = {NULL, y};
+  const void* bBuffers[] = {NULL, b};
+  ArrowArray aArray = array(4, 1, aBuffers);
+  ArrowArray yArray = array(4, 0, yBuffers);
+  ArrowArray bArray = array(4, 0, bBuffers);
+  ArrowArray* children[] = {&aArray, &yArray, &bArray};
+  const void* batchBuffers[] = {&batchValidity};
+  ArrowArray batch = {3, 1, 1, 1, 3, batchBuffers, children, NULL, NULL, NULL};
+
+  ArrowSchema aSchema = column("f", "a");
+  ArrowSchema ySchema = column("f", "y");
+  ArrowSchema bSchema = column("i", "b");
+  ArrowSchema* schemaChildren[] = {&aSchema, &ySchema, &bSchema};
+  ArrowSchema schema = {"+s", "", NULL, 0, 3, schemaChildren, NULL, NULL, NULL};
+
+  // null features become NaN
+  ArrowMatrix matrix;
+  std::string error;
+  CHECK(importArrowBatch(&schema, &batch, NULL, &matrix, &error));
+  CHECK(matrix.nrow == 3);
+  CHECK(matrix.ncol == 3);
+  CHECK(matrix.dataType == C_API_DTYPE_FLOAT64);
+  CHECK(matrix.label.empty());
+  const double features[] = {NAN, 3, NAN, 1, 0, NAN, 20, 30, NAN};
+  CHECK(matrix.float64.size() == 9);
+  for (size_t i = 0; i < matrix.float64.size() && i < 9; ++i) {
+    CHECK(same(matrix.float64[i], features[i]));
+  }
+
+  // the batch null of row 3 would be a label
+  ArrowMatrix labelled;
+  CHECK(!importArrowBatch(&schema, &batch, "y", &labelled, &error));
+
+  // without batch nulls y is moved to the label, a keeps its NaN
+  batch.null_count = 0;
+  batchBuffers[0] = NULL;
+  CHECK(importArrowBatch(&schema, &batch, "y", &labelled, &error));
+  CHECK(labelled.ncol == 2);
+  const double labelledFeatures[] = {NAN, 3, 4, 20, 30, 40};
+  CHECK(labelled.float64.size() == 6);
+  for (size_t i = 0; i < labelled.float64.size() && i < 6; ++i) {
+    CHECK(same(labelled.float64[i], labelledFeatures[i]));
+  }
+  const float label[] = {1, 0, 1};
+  CHECK(labelled.label.size() == 3);
+  for (size_t i = 0; i < labelled.label.size() && i < 3; ++i) {
+    CHECK(same(labelled.label[i], label[i]));
+  }
+
+  // a null in the label column itself
+  ArrowMatrix nullLabel;
+  CHECK(!importArrowBatch(&schema, &batch, "a", &nullLabel, &error));
+}
+
+static void testRejects() {
+  float a[] = {1, 2, 3, 4};
+  const void* aBuffers[] = {NULL, a};
+  ArrowArray aArray = array(4, 0, aBuffers);
+  ArrowArray* children[] = {&aArray};
+  const void* batchBuffers[] = {NULL};
+  ArrowArray batch = {4, 0, 1, 1, 1, batchBuffers, children, NULL, NULL, NULL};
+  ArrowSchema aSchema = column("f", "a");
+  ArrowSchema* schemaChildren[] = {&aSchema};
+  ArrowSchema schema = {"+s", "", NULL, 0, 1, schemaChildren, NULL, NULL, NULL};
+  ArrowMatrix matrix;
+  std::string error;
+
+  // offset 1 + length 4 reads past the four row child
+  CHECK(!importArrowBatch(&schema, &batch, NULL, &matrix, &error));
+  batch.length = 3;
+  CHECK(importArrowBatch(&schema, &batch, NULL, &matrix, &error));
+
+  ArrowSchema dictionary = column("u", NULL);
+  aSchema.format = "i";
+  aSchema.dictionary = &dictionary;
+  CHECK(!importArrowBatch(&schema, &batch, NULL, &matrix, &error));
+}
+
+int main() {
+  testImport();
+  testRejects();
+  if (failures == 0) std::printf("PASS\n");
+  return failures == 0 ? 0 : 1;
+}